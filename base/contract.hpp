@@ -4,6 +4,8 @@
 
 #include <source_location>
 
+#include "base/core.hpp"
+
 namespace simon::framework::contract {
 struct ContractError {
   std::source_location origin;
@@ -12,25 +14,30 @@ struct ContractError {
 struct PreconditionError final : public ContractError {};
 struct PostconditionError final : public ContractError {};
 struct InvariantError final : public ContractError {};
+
+// Failures are raised out of line so that a check inlines as a compare and a branch. How they
+// are raised follows `CONTRACT_LEVEL`, see base/core.hpp.
+template <typename ErrorType>
+[[noreturn]] DECLARE_COLD void fail(const char* condition, std::source_location origin) {
+#if CONTRACT_LEVEL == CONTRACT_LEVEL_ABORT
+  impl::abort_contract(to_type_string<ErrorType>().c_str(), condition, origin);
+#else
+  DECLARE_UNUSED(condition);
+  throw ErrorType{origin};
+#endif
+}
 }  // namespace simon::framework::contract
 
-#define EXPECT(expr)                                                                 \
-  [&] {                                                                              \
-    if (!(expr)) [[unlikely]] {                                                      \
-      throw framework::contract::PreconditionError{std::source_location::current()}; \
-    }                                                                                \
-  }()
-
-#define ENSURE(expr)                                                                  \
-  [&] {                                                                               \
-    if (!(expr)) [[unlikely]] {                                                       \
-      throw framework::contract::PostconditionError{std::source_location::current()}; \
-    }                                                                                 \
-  }()
-
-#define ASSERT(expr)                                                              \
-  [&] {                                                                           \
-    if (!(expr)) [[unlikely]] {                                                   \
-      throw framework::contract::InvariantError{std::source_location::current()}; \
-    }                                                                             \
-  }()
+#if CONTRACT_LEVEL == CONTRACT_LEVEL_OFF
+#define CHECK_CONTRACT_EXPRESSION__(expr, error_type) static_cast<void>(sizeof(!(expr)))
+#else
+#define CHECK_CONTRACT_EXPRESSION__(expr, error_type) \
+  ((expr) ? static_cast<void>(0)                      \
+          : ::simon::framework::contract::fail<error_type>(#expr, std::source_location::current()))
+#endif
+
+#define EXPECT(expr) \
+  CHECK_CONTRACT_EXPRESSION__(expr, ::simon::framework::contract::PreconditionError)
+#define ENSURE(expr) \
+  CHECK_CONTRACT_EXPRESSION__(expr, ::simon::framework::contract::PostconditionError)
+#define ASSERT(expr) CHECK_CONTRACT_EXPRESSION__(expr, ::simon::framework::contract::InvariantError)
@@ -0,0 +1,113 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+// Measures what one check per element costs a tight loop at each contract
+// level, against the same loop unchecked and against checks that format their
+// failure inline. Run with `bazel run //base:contract_benchmark`, under any
+// `--config=contract_<level>`.
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "base/contract.hpp"
+#include "base/testing.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+namespace simon {
+namespace {
+
+constexpr std::size_t VALUE_COUNT = 1 << 16;
+
+// How checks failed before they moved out of line.
+#define CHECK_INLINE_FORMAT(condition__)                                    \
+  if (!(condition__)) [[unlikely]] {                                        \
+    const auto current_location__ = std::source_location::current();        \
+    throw std::logic_error(std::format(                                     \
+        "[{}] {} Failed {}: {}", current_location__.file_name(),            \
+        current_location__.function_name(), "Precondition", #condition__)); \
+  }
+
+std::vector<std::int32_t> random_values() {
+  std::mt19937 generate{42};
+  std::uniform_int_distribution<std::int32_t> uniform{0, 1000};
+  std::vector<std::int32_t> values(VALUE_COUNT);
+  for (auto& value : values) {
+    value = uniform(generate);
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST_CASE("ContractCheck") {
+  const std::vector<std::int32_t> values = random_values();
+
+  BENCHMARK("Unchecked") {
+    std::int64_t sum = 0;
+    for (auto value : values) {
+      sum += value;
+    }
+    return sum;
+  };
+
+  BENCHMARK("Off") {
+    std::int64_t sum = 0;
+    for (auto value : values) {
+      CHECK_CONTRACT_OFF__(value >= 0, "Precondition");
+      sum += value;
+    }
+    return sum;
+  };
+
+  BENCHMARK("Abort") {
+    std::int64_t sum = 0;
+    for (auto value : values) {
+      CHECK_CONTRACT_ABORT__(value >= 0, "Precondition");
+      sum += value;
+    }
+    return sum;
+  };
+
+  // Audit makes the same checks as throw, and more of them.
+  BENCHMARK("Throw") {
+    std::int64_t sum = 0;
+    for (auto value : values) {
+      CHECK_CONTRACT_THROW__(value >= 0, "Precondition");
+      sum += value;
+    }
+    return sum;
+  };
+
+  BENCHMARK("InlineFormat") {
+    std::int64_t sum = 0;
+    for (auto value : values) {
+      CHECK_INLINE_FORMAT(value >= 0);
+      sum += value;
+    }
+    return sum;
+  };
+}
+
+TEST_CASE("ContractCheckAtConfiguredLevel") {
+  const std::vector<std::int32_t> values = random_values();
+
+  BENCHMARK("Expect") {
+    std::int64_t sum = 0;
+    for (auto value : values) {
+      EXPECT(value >= 0);
+      sum += value;
+    }
+    return sum;
+  };
+
+  BENCHMARK("CheckedPointer") {
+    std::int64_t sum = 0;
+    for (const auto& value : values) {
+      CheckedPointer<const std::int32_t> pointer{value};
+      sum += *pointer;
+    }
+    return sum;
+  };
+}
+
+}  // namespace simon
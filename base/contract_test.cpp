@@ -6,6 +6,8 @@
 
 namespace simon::framework {
 
+// Failures only throw at the throwing levels, which is what tests are built with by default.
+#if CONTRACT_LEVEL >= CONTRACT_LEVEL_THROW
 TEST_CASE("Contracts") {
   SECTION("ShouldThrowOnPreconditionFailure") {
     REQUIRE_THROWS_AS(EXPECT(false), contract::PreconditionError);
@@ -46,6 +48,53 @@ TEST_CASE("Contracts") {
   SECTION("ShouldNotThrowOnInvariantSuccess") {
     REQUIRE_NOTHROW(ASSERT(true));
   }
+  SECTION("ShouldHaveCallerSourceLocationOnFailure") {
+    const auto location = std::source_location::current();
+    try {
+      EXPECT(false);
+    } catch (const contract::PreconditionError& e) {
+      CHECK(e.origin.line() == location.line() + 2);
+    }
+  }
+  SECTION("ShouldEvaluateConditionOnce") {
+    int evaluations = 0;
+    EXPECT(++evaluations > 0);
+    CHECK(evaluations == 1);
+  }
+  SECTION("ShouldThrowOnCheckFailure") {
+    auto check = [](bool condition) { CHECK_PRECONDITION(condition); };
+    REQUIRE_THROWS_AS(check(false), std::logic_error);
+    REQUIRE_NOTHROW(check(true));
+  }
+}
+#endif
+
+#if CONTRACT_LEVEL == CONTRACT_LEVEL_OFF
+TEST_CASE("ContractsOff") {
+  SECTION("ShouldNotEvaluateCondition") {
+    int evaluations = 0;
+    EXPECT(++evaluations > 0);
+    CHECK_PRECONDITION(++evaluations > 0);
+    CHECK(evaluations == 0);
+  }
+}
+#endif
+
+#if CONTRACT_LEVEL != CONTRACT_LEVEL_AUDIT
+TEST_CASE("AuditChecks") {
+  SECTION("ShouldNotEvaluateConditionBelowAudit") {
+    int evaluations = 0;
+    CHECK_AUDIT(++evaluations > 0);
+    CHECK(evaluations == 0);
+  }
+}
+#else
+TEST_CASE("AuditChecks") {
+  SECTION("ShouldThrowOnAuditFailure") {
+    auto audit = [](bool condition) { CHECK_AUDIT(condition); };
+    REQUIRE_THROWS_AS(audit(false), std::logic_error);
+  }
 }
+#endif
 
 }  // namespace simon::framework
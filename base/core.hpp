@@ -1,9 +1,12 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <bit>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <format>
 #include <functional>
@@ -12,6 +15,8 @@
 #include <memory>
 #include <print>
 #include <source_location>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -68,14 +73,57 @@
 #define DECLARE_USED(expression__) ((void)(sizeof(expression__)))
 #define DECLARE_UNUSED(expression__) ((void)(sizeof(expression__)))
 
-#define CHECK_CONTRACT__(condition__, kind__)                        \
-  if (!(condition__)) [[unlikely]] {                                 \
-    const auto current_location__ = std::source_location::current(); \
-    throw std::logic_error(std::format(                              \
-        "[{}] {} Failed {}: {}", current_location__.file_name(),     \
-        current_location__.function_name(), kind__, #condition__));  \
+#if defined(__GNUC__)
+#define DECLARE_COLD __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define DECLARE_COLD __declspec(noinline)
+#else
+#define DECLARE_COLD
+#endif
+
+// Contract levels, selected with `--config=contract_<level>`, see .bazelrc:
+// - OFF: checks are compiled out and their conditions are not evaluated.
+// - ABORT: a failed check reports where it failed and aborts.
+// - THROW: a failed check throws `std::logic_error`. The default.
+// - AUDIT: as THROW, and checks too costly for THROW are made as well.
+// Failures are handled out of line, so a check costs its hot path a compare
+// and a branch.
+#define CONTRACT_LEVEL_OFF 0
+#define CONTRACT_LEVEL_ABORT 1
+#define CONTRACT_LEVEL_THROW 2
+#define CONTRACT_LEVEL_AUDIT 3
+
+#ifndef CONTRACT_LEVEL
+#define CONTRACT_LEVEL CONTRACT_LEVEL_THROW
+#endif
+
+#define CHECK_CONTRACT_ABORT__(condition__, kind__)                 \
+  if (!(condition__)) [[unlikely]] {                                \
+    ::simon::impl::abort_contract(kind__, #condition__,             \
+                                  std::source_location::current()); \
   }
 
+#define CHECK_CONTRACT_THROW__(condition__, kind__)                 \
+  if (!(condition__)) [[unlikely]] {                                \
+    ::simon::impl::throw_contract(kind__, #condition__,             \
+                                  std::source_location::current()); \
+  }
+
+#define CHECK_CONTRACT_OFF__(condition__, kind__) \
+  if (false && (condition__)) {                   \
+  }
+
+#if CONTRACT_LEVEL == CONTRACT_LEVEL_OFF
+#define CHECK_CONTRACT__(condition__, kind__) \
+  CHECK_CONTRACT_OFF__(condition__, kind__)
+#elif CONTRACT_LEVEL == CONTRACT_LEVEL_ABORT
+#define CHECK_CONTRACT__(condition__, kind__) \
+  CHECK_CONTRACT_ABORT__(condition__, kind__)
+#else
+#define CHECK_CONTRACT__(condition__, kind__) \
+  CHECK_CONTRACT_THROW__(condition__, kind__)
+#endif
+
 #define CHECK_PRECONDITION(precondition__) \
   CHECK_CONTRACT__(precondition__, "Precondition")
 #define CHECK_POSTCONDITION(postcondition__) \
@@ -83,7 +131,39 @@
 #define CHECK_INVARIANT(invariant__) CHECK_CONTRACT__(invariant__, "Invariant")
 #define CHECK_UNREACHABLE() CHECK_CONTRACT__(false, "Unreachable")
 
+#if CONTRACT_LEVEL == CONTRACT_LEVEL_AUDIT
+#define CHECK_AUDIT(audit__) CHECK_CONTRACT__(audit__, "Audit")
+#else
+#define CHECK_AUDIT(audit__) CHECK_CONTRACT_OFF__(audit__, "Audit")
+#endif
+
+// Lives outside of any namespace: compilers leave out the qualifiers that a
+// type shares with the function naming it, see `simon::to_type_name`.
+template <typename Type>
+constexpr std::string_view simon_type_signature() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+  return __FUNCSIG__;
+#else
+  return __PRETTY_FUNCTION__;
+#endif
+}
+
 namespace simon {
+namespace impl {
+[[noreturn]] DECLARE_COLD inline void abort_contract(
+    char const* kind, char const* condition, std::source_location location) {
+  std::print(stderr, "[{}:{}] {} Failed {}: {}\n", location.file_name(),
+             location.line(), location.function_name(), kind, condition);
+  std::abort();
+}
+
+[[noreturn]] DECLARE_COLD inline void throw_contract(
+    char const* kind, char const* condition, std::source_location location) {
+  throw std::logic_error(
+      std::format("[{}] {} Failed {}: {}", location.file_name(),
+                  location.function_name(), kind, condition));
+}
+}  // namespace impl
 
 inline std::size_t allocate_static_increment() {
   static std::atomic<std::size_t> increment = 0;
@@ -258,6 +338,29 @@ std::string to_type_string(Type&& object) {
   return demangle(typeid(decltype(object)).name());
 }
 
+// The name of `Type` as the compiler spells it, read at compile time from the
+// signature of `simon_type_signature`. Unlike `to_type_string` it costs nothing
+// at run time, but its spelling may differ between compilers.
+template <typename Type>
+constexpr std::string_view to_type_name() noexcept {
+  constexpr std::string_view signature = simon_type_signature<Type>();
+#if defined(_MSC_VER) && !defined(__clang__)
+  // "... __cdecl simon_type_signature<TYPE>(void) noexcept"
+  constexpr std::string_view prefix = "simon_type_signature<";
+  constexpr auto begin = signature.find(prefix) + prefix.size();
+  constexpr auto end = signature.rfind(">(void)");
+#else
+  // GCC: "... [with Type = TYPE; std::string_view = ...]"
+  // Clang: "... [Type = TYPE]"
+  constexpr std::string_view prefix = "Type = ";
+  constexpr auto begin = signature.find(prefix) + prefix.size();
+  constexpr auto end = signature.find(';', begin) != std::string_view::npos
+                           ? signature.find(';', begin)
+                           : signature.rfind(']');
+#endif
+  return signature.substr(begin, end - begin);
+}
+
 template <typename ObjectType>
 void dump_object_bytes(const ObjectType& object) {
   std::print("** {}: ", to_type_string<ObjectType>());
@@ -269,40 +372,175 @@ void dump_object_bytes(const ObjectType& object) {
   std::print("\n");
 }
 
-inline std::size_t stable_hash(std::string_view str) {
-  static const auto shuffle_ = [](std::uint64_t block) {
-    return  // clang-format off
-      ((block & 0xFFFF'0000'0000'0000) >> 16) |
-      ((block & 0x0000'FFFF'0000'0000) >> 32) |
-      ((block & 0x0000'0000'FFFF'0000) << 32) |
-      ((block & 0x0000'0000'0000'FFFF) << 16);
-    // clang-format on
-  };
+namespace impl {
+constexpr std::uint64_t STABLE_HASH_M1 = 0xC2B2AE35C2B2AE35;
+constexpr std::uint64_t STABLE_HASH_M2 = 0x42F0E1EBA9EA3693;
+constexpr std::uint64_t STABLE_HASH_M3 = 0xC96C5795D7870F42;
+constexpr std::size_t STABLE_HASH_BLOCK_SIZE = 8;
+
+constexpr std::uint64_t stable_hash_shuffle(std::uint64_t block) noexcept {
+  return  // clang-format off
+    ((block & 0xFFFF'0000'0000'0000) >> 16) |
+    ((block & 0x0000'FFFF'0000'0000) >> 32) |
+    ((block & 0x0000'0000'FFFF'0000) << 32) |
+    ((block & 0x0000'0000'0000'FFFF) << 16);
+  // clang-format on
+}
 
-  static const auto diffuse_ = [](std::uint64_t block, std::uint64_t a,
-                                  std::uint64_t b) {
-    return (block * a) ^ (~block * b);
-  };
+constexpr std::uint64_t stable_hash_diffuse(std::uint64_t block,
+                                            std::uint64_t a,
+                                            std::uint64_t b) noexcept {
+  return (block * a) ^ (~block * b);
+}
+
+// Blocks are read little-endian whatever the platform.
+template <typename ByteType>
+constexpr std::uint64_t stable_hash_block(ByteType const* bytes) noexcept {
+  if !consteval {
+    std::uint64_t block;
+    std::memcpy(&block, bytes, STABLE_HASH_BLOCK_SIZE);
+    if constexpr (std::endian::native == std::endian::big) {
+      block = std::byteswap(block);
+    }
+    return block;
+  }
+  std::uint64_t block = 0;
+  for (std::size_t i = 0; i < STABLE_HASH_BLOCK_SIZE; ++i) {
+    block |= std::uint64_t{static_cast<std::uint8_t>(bytes[i])} << (8 * i);
+  }
+  return block;
+}
 
-  constexpr std::uint64_t m1 = 0xC2B2AE35C2B2AE35;
-  constexpr std::uint64_t m2 = 0x42F0E1EBA9EA3693;
-  constexpr std::uint64_t m3 = 0xC96C5795D7870F42;
-  constexpr std::uint64_t block_size = 8;
+// Trailing bytes widen as signed whatever the signedness of `char`, as they
+// always did on x86, so that hashes computed there keep their values.
+template <typename ByteType>
+constexpr std::uint64_t stable_hash_byte(ByteType byte) noexcept {
+  return static_cast<std::uint64_t>(
+      static_cast<std::int64_t>(static_cast<signed char>(byte)));
+}
 
+template <typename ByteType>
+constexpr std::uint64_t stable_hash_tail(std::uint64_t result,
+                                         ByteType const* bytes,
+                                         std::size_t size) noexcept {
   std::size_t i = 0;
-  std::uint64_t block;
-  std::uint64_t result = diffuse_(str.size(), m1, m2);
+  for (; i + STABLE_HASH_BLOCK_SIZE <= size; i += STABLE_HASH_BLOCK_SIZE) {
+    result = stable_hash_shuffle(result) ^
+             stable_hash_diffuse(stable_hash_block(bytes + i),
+                                 ~STABLE_HASH_M2, STABLE_HASH_M3);
+  }
+  for (; i < size; i++) {
+    result = stable_hash_shuffle(result) ^
+             stable_hash_diffuse(stable_hash_byte(bytes[i]), STABLE_HASH_M3,
+                                 ~STABLE_HASH_M1);
+  }
+  return result;
+}
+}  // namespace impl
+
+// Hashes the same bytes to the same value on every platform and in every
+// build, so that hashes may be stored. One block at a time, for short keys.
+constexpr std::size_t stable_hash(std::string_view str) noexcept {
+  std::uint64_t result = impl::stable_hash_diffuse(
+      str.size(), impl::STABLE_HASH_M1, impl::STABLE_HASH_M2);
+  result = impl::stable_hash_tail(result, str.data(), str.size());
+  return impl::stable_hash_diffuse(result, impl::STABLE_HASH_M2,
+                                   ~impl::STABLE_HASH_M3);
+}
+
+// Hashes bytes fed in any number of pieces as `stable_hash_wide` would hash
+// them all at once. Independent lanes each take one block of every stripe, so
+// that their multiplies overlap, and are folded together at the end.
+class StableHasher final {
+ public:
+  DECLARE_COPY_DEFAULT_CONSTEXPR(StableHasher);
+  DECLARE_MOVE_DEFAULT_CONSTEXPR(StableHasher);
+
+  static constexpr std::size_t LANE_COUNT = 4;
+  static constexpr std::size_t STRIPE_SIZE =
+      LANE_COUNT * impl::STABLE_HASH_BLOCK_SIZE;
+
+  constexpr StableHasher() noexcept {
+    for (std::size_t lane = 0; lane < LANE_COUNT; ++lane) {
+      lanes_[lane] = impl::stable_hash_diffuse(lane, impl::STABLE_HASH_M1,
+                                               impl::STABLE_HASH_M2);
+    }
+  }
+  constexpr ~StableHasher() = default;
+
+  constexpr StableHasher& update(std::string_view bytes) noexcept {
+    return update(bytes.data(), bytes.size());
+  }
+
+  constexpr StableHasher& update(std::span<std::byte const> bytes) noexcept {
+    return update(bytes.data(), bytes.size());
+  }
 
-  for (; i < str.size() && block_size <= str.size(); i += block_size) {
-    std::memcpy(&block, str.data() + i, block_size);
-    result = shuffle_(result) ^ diffuse_(block, ~m2, m3);
+  constexpr std::uint64_t digest() const noexcept {
+    std::uint64_t result = impl::stable_hash_diffuse(
+        size_, impl::STABLE_HASH_M1, impl::STABLE_HASH_M2);
+    for (std::uint64_t lane : lanes_) {
+      result = impl::stable_hash_shuffle(result) ^
+               impl::stable_hash_diffuse(lane, ~impl::STABLE_HASH_M2,
+                                         impl::STABLE_HASH_M3);
+    }
+    result = impl::stable_hash_tail(result, buffer_.data(), buffered_);
+    return impl::stable_hash_diffuse(result, impl::STABLE_HASH_M2,
+                                     ~impl::STABLE_HASH_M3);
   }
 
-  for (; i < str.size(); i++) {
-    result = shuffle_(result) ^ diffuse_(str[i], m3, ~m1);
+ private:
+  template <typename ByteType>
+  constexpr StableHasher& update(ByteType const* bytes,
+                                 std::size_t size) noexcept {
+    size_ += size;
+    if (buffered_) {
+      while (size && buffered_ < STRIPE_SIZE) {
+        buffer_[buffered_++] = static_cast<std::uint8_t>(*bytes++);
+        size--;
+      }
+      if (buffered_ < STRIPE_SIZE) {
+        return *this;
+      }
+      consume(buffer_.data());
+      buffered_ = 0;
+    }
+    for (; size >= STRIPE_SIZE; bytes += STRIPE_SIZE, size -= STRIPE_SIZE) {
+      consume(bytes);
+    }
+    while (size--) {
+      buffer_[buffered_++] = static_cast<std::uint8_t>(*bytes++);
+    }
+    return *this;
   }
 
-  return diffuse_(result, m2, ~m3);
+  template <typename ByteType>
+  constexpr void consume(ByteType const* stripe) noexcept {
+    for (std::size_t lane = 0; lane < LANE_COUNT; ++lane) {
+      lanes_[lane] =
+          impl::stable_hash_shuffle(lanes_[lane]) ^
+          impl::stable_hash_diffuse(
+              impl::stable_hash_block(stripe +
+                                      lane * impl::STABLE_HASH_BLOCK_SIZE),
+              ~impl::STABLE_HASH_M2, impl::STABLE_HASH_M3);
+    }
+  }
+
+  std::array<std::uint64_t, LANE_COUNT> lanes_{};
+  std::array<std::uint8_t, STRIPE_SIZE> buffer_{};
+  std::size_t buffered_ = 0;
+  std::uint64_t size_ = 0;
+};
+
+// Hashes large buffers, such as fingerprints of world state, several blocks at
+// a time. Stable like `stable_hash`, though the two hash to different values.
+constexpr std::uint64_t stable_hash_wide(std::string_view bytes) noexcept {
+  return StableHasher{}.update(bytes).digest();
+}
+
+constexpr std::uint64_t stable_hash_wide(
+    std::span<std::byte const> bytes) noexcept {
+  return StableHasher{}.update(bytes).digest();
 }
 
 }  // namespace simon
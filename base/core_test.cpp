@@ -0,0 +1,111 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "base/core.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "base/testing.hpp"
+
+namespace simon {
+
+constexpr std::string_view SENTENCE =
+    "The quick brown fox jumps over the lazy dog, twice over.";
+
+TEST_CASE("TypeName") {
+  SECTION("ShouldSpellTypeAtCompileTime") {
+    // Postconditions.
+    STATIC_REQUIRE(to_type_name<int>() == "int");
+    STATIC_REQUIRE(to_type_name<StableHasher>() == "simon::StableHasher");
+  }
+
+  SECTION("ShouldSpellTypeAsDemangledTypeInfo") {
+    // Postconditions.
+    REQUIRE(to_type_name<StableHasher>() == to_type_string<StableHasher>());
+  }
+}
+
+TEST_CASE("StableHash") {
+  SECTION("ShouldHashToSameValuesInEveryBuild") {
+    // Postconditions.
+    REQUIRE(stable_hash("") == 0xEEE234C470228E5D);
+    REQUIRE(stable_hash("a") == 0xF0D941E1E47D7FD5);
+    REQUIRE(stable_hash("simon") == 0xA61D50D86EF6137D);
+    REQUIRE(stable_hash(SENTENCE) == 0x2C00FE98B54EB2C3);
+  }
+
+  SECTION("ShouldWidenHighBytesSameWhateverCharSignedness") {
+    // Postconditions.
+    REQUIRE(stable_hash("\xff\x80 high bytes \xfe") == 0x8A3DC4AB261D5943);
+  }
+
+  SECTION("ShouldBeConstexpr") {
+    // Postconditions.
+    STATIC_REQUIRE(stable_hash("simon") == 0xA61D50D86EF6137D);
+    STATIC_REQUIRE(stable_hash(SENTENCE) == 0x2C00FE98B54EB2C3);
+  }
+
+  SECTION("ShouldHashDifferentStringsDifferently") {
+    // Postconditions.
+    REQUIRE(stable_hash("simon") != stable_hash("nomis"));
+    REQUIRE(stable_hash("a") != stable_hash(std::string_view{"a\0", 2}));
+  }
+}
+
+TEST_CASE("StableHashWide") {
+  SECTION("ShouldHashToSameValuesInEveryBuild") {
+    // Postconditions.
+    REQUIRE(stable_hash_wide("") == 0xFFB9FF1AB0E46F7D);
+    REQUIRE(stable_hash_wide("simon") == 0x000F978131954C4D);
+    REQUIRE(stable_hash_wide(SENTENCE) == 0x0E7B65BED4844975);
+  }
+
+  SECTION("ShouldBeConstexpr") {
+    // Postconditions.
+    STATIC_REQUIRE(stable_hash_wide(SENTENCE) == 0x0E7B65BED4844975);
+  }
+
+  SECTION("ShouldHashBytesAsString") {
+    // Under Test.
+    auto bytes = std::as_bytes(std::span{SENTENCE});
+
+    // Postconditions.
+    REQUIRE(stable_hash_wide(bytes) == stable_hash_wide(SENTENCE));
+  }
+
+  SECTION("ShouldHashSameWhereverInputIsSplit") {
+    // Preconditions.
+    std::string input;
+    for (std::size_t i = 0; i < 3 * StableHasher::STRIPE_SIZE + 5; ++i) {
+      input.push_back(static_cast<char>(i * 37));
+    }
+    const std::uint64_t whole = stable_hash_wide(input);
+
+    for (std::size_t first = 0; first <= input.size(); ++first) {
+      for (std::size_t second = first; second <= input.size(); second += 7) {
+        // Under Test.
+        StableHasher hasher;
+        hasher.update(std::string_view{input}.substr(0, first))
+            .update(std::string_view{input}.substr(first, second - first))
+            .update(std::string_view{input}.substr(second));
+
+        // Postconditions.
+        REQUIRE(hasher.digest() == whole);
+      }
+    }
+  }
+
+  SECTION("ShouldHashEachLaneDifferently") {
+    // Preconditions.
+    std::string stripe(StableHasher::STRIPE_SIZE, '\0');
+    std::string swapped = stripe;
+    stripe[0] = 'x';
+    swapped[StableHasher::STRIPE_SIZE / 2] = 'x';
+
+    // Postconditions.
+    REQUIRE(stable_hash_wide(stripe) != stable_hash_wide(swapped));
+  }
+}
+
+}  // namespace simon
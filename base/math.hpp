@@ -6,14 +6,81 @@
 
 namespace simon {
 
+// Scalar type of the simulation's math. Double precision unless built with
+// `--config=float`, which defines SIMON_MATH_FLOAT for every dependent target.
+#ifdef SIMON_MATH_FLOAT
+using Scalar = float;
+#else
+using Scalar = double;
+#endif
+
+template <typename ScalarType, std::size_t Rows, std::size_t Cols>
+using BasicMatrix = Eigen::Matrix<ScalarType, Rows, Cols>;
+
+template <typename ScalarType, std::size_t Size>
+using BasicVector = Eigen::Matrix<ScalarType, Size, 1>;
+
 template <std::size_t Rows, std::size_t Cols>
-using Matrix = Eigen::Matrix<double, Rows, Cols>;
+using Matrix = BasicMatrix<Scalar, Rows, Cols>;
 
 template <std::size_t Size>
-using Vector = Eigen::Matrix<double, Size, 1>;
+using Vector = BasicVector<Scalar, Size>;
 
 using Vec3 = Vector<3>;
 using Vec2 = Vector<2>;
 
+// Three-dimensional vector stored as four lanes (x, y, z, w), so that it is
+// aligned and sized for Eigen's packet math where an odd-sized `Vec3` runs
+// scalar. The padding lane starts at zero and stays zero under the linear
+// operations used by the simulation (sums, differences and scaling), so norms
+// and dot products agree with the unpadded vector. Whatever the padding lane of
+// an expression holds, it is zeroed on construction and assignment.
+template <typename ScalarType>
+class BasicPaddedVector3 : public Eigen::Matrix<ScalarType, 4, 1> {
+  using BaseType = Eigen::Matrix<ScalarType, 4, 1>;
+
+ public:
+  BasicPaddedVector3() : BaseType{BaseType::Zero()} {}
+
+  BasicPaddedVector3(ScalarType x, ScalarType y, ScalarType z)
+      : BaseType{x, y, z, ScalarType{0}} {}
+
+  // Interoperates with any four-lane Eigen expression.
+  template <typename OtherDerived>
+    requires(OtherDerived::SizeAtCompileTime == 4)
+  BasicPaddedVector3(const Eigen::MatrixBase<OtherDerived>& that)
+      : BaseType{that} {
+    this->w() = ScalarType{0};
+  }
+
+  // And with any three-lane one, such as a `Vec3` or a sum of them, padded.
+  template <typename OtherDerived>
+    requires(OtherDerived::SizeAtCompileTime == 3)
+  BasicPaddedVector3(const Eigen::MatrixBase<OtherDerived>& that) {
+    *this = that;
+  }
+
+  template <typename OtherDerived>
+    requires(OtherDerived::SizeAtCompileTime == 4)
+  BasicPaddedVector3& operator=(const Eigen::MatrixBase<OtherDerived>& that) {
+    BaseType::operator=(that);
+    this->w() = ScalarType{0};
+    return *this;
+  }
+
+  template <typename OtherDerived>
+    requires(OtherDerived::SizeAtCompileTime == 3)
+  BasicPaddedVector3& operator=(const Eigen::MatrixBase<OtherDerived>& that) {
+    xyz() = that;
+    this->w() = ScalarType{0};
+    return *this;
+  }
+
+  auto xyz() { return this->template head<3>(); }
+  auto xyz() const { return this->template head<3>(); }
+};
+
+using PaddedVec3 = BasicPaddedVector3<Scalar>;
+
 }  // namespace simon
 
@@ -11,15 +11,103 @@ namespace simon {
 constexpr size_t N = 3;
 constexpr size_t M = 3;
 
+TEST_CASE("Scalar") {
+  SECTION("IsFloatingPoint") {
+    REQUIRE(std::is_floating_point_v<Scalar>);
+  }
+
+#ifdef SIMON_MATH_FLOAT
+  SECTION("IsFloatWhenSelected") {
+    REQUIRE(std::is_same_v<Scalar, float>);
+  }
+#else
+  SECTION("IsDoubleByDefault") {
+    REQUIRE(std::is_same_v<Scalar, double>);
+  }
+#endif
+}
+
 TEST_CASE("Matrix") {
   SECTION("IsEigenMatrix") {
-    REQUIRE(std::is_same_v<Matrix<N, M>, Eigen::Matrix<double, N, M>>);
+    REQUIRE(std::is_same_v<Matrix<N, M>, Eigen::Matrix<Scalar, N, M>>);
+  }
+
+  SECTION("IsEigenMatrixOfAnyScalar") {
+    REQUIRE(std::is_same_v<BasicMatrix<float, N, M>, Eigen::Matrix<float, N, M>>);
+    REQUIRE(std::is_same_v<BasicMatrix<double, N, M>, Eigen::Matrix<double, N, M>>);
   }
 }
 
 TEST_CASE("Vector") {
   SECTION("IsEigenMatrix") {
-    REQUIRE(std::is_same_v<Vector<N>, Eigen::Matrix<double, N, 1>>);
+    REQUIRE(std::is_same_v<Vector<N>, Eigen::Matrix<Scalar, N, 1>>);
+  }
+
+  SECTION("IsEigenMatrixOfAnyScalar") {
+    REQUIRE(std::is_same_v<BasicVector<float, N>, Eigen::Matrix<float, N, 1>>);
+    REQUIRE(std::is_same_v<BasicVector<double, N>, Eigen::Matrix<double, N, 1>>);
+  }
+}
+
+TEST_CASE("PaddedVec3") {
+  PaddedVec3 a{1.0, 2.0, 3.0};
+  PaddedVec3 b{Vec3{4.0, 5.0, 6.0}};
+
+  SECTION("ShouldBeFourLanesWide") {
+    REQUIRE(sizeof(PaddedVec3) == 4 * sizeof(Scalar));
+    REQUIRE(alignof(PaddedVec3) >= 2 * sizeof(Scalar));
+  }
+
+  SECTION("ShouldDefaultToZero") {
+    PaddedVec3 zero;
+    CHECK(zero.isZero());
+  }
+
+  SECTION("ShouldPadWithZero") {
+    CHECK(a.w() == Scalar{0});
+    CHECK(b.w() == Scalar{0});
+  }
+
+  SECTION("ShouldZeroPaddingOfFourLaneExpressions") {
+    using Lanes = Eigen::Matrix<Scalar, 4, 1>;
+    PaddedVec3 c = Lanes::Ones();
+    CHECK(c.w() == Scalar{0});
+    CHECK(c.xyz() == Vec3::Ones());
+
+    c = Lanes::Constant(Scalar{2});
+    CHECK(c.w() == Scalar{0});
+    CHECK(c.xyz() == Vec3::Constant(Scalar{2}));
+  }
+
+  SECTION("ShouldPadThreeLaneExpressions") {
+    Vec3 u{1.0, 2.0, 3.0};
+    Vec3 v{4.0, 5.0, 6.0};
+    PaddedVec3 difference = u - v;
+    CHECK(difference.w() == Scalar{0});
+    CHECK(difference.xyz() == u - v);
+
+    PaddedVec3 scaled = 2 * u;
+    CHECK(scaled.w() == Scalar{0});
+    CHECK(scaled.xyz() == Scalar{2} * u);
+
+    scaled = v;
+    CHECK(scaled.w() == Scalar{0});
+    CHECK(scaled.xyz() == v);
+  }
+
+  SECTION("ShouldKeepZeroPaddingUnderLinearOperations") {
+    PaddedVec3 c = (a - b) * Scalar{2} + a;
+    CHECK(c.w() == Scalar{0});
+  }
+
+  SECTION("ShouldHaveSameNormAsUnpaddedVector") {
+    Vec3 unpadded = Vec3{1.0, 2.0, 3.0} - Vec3{4.0, 5.0, 6.0};
+    CHECK(static_cast<PaddedVec3>(a - b).norm() == unpadded.norm());
+  }
+
+  SECTION("ShouldConvertToUnpaddedVector") {
+    Vec3 c = a.xyz();
+    CHECK(c == Vec3{1.0, 2.0, 3.0});
   }
 }
 
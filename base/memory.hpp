@@ -0,0 +1,242 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "base/core.hpp"
+
+namespace simon {
+
+struct MemoryUsage final {
+  std::size_t reserved = 0;     // Bytes allocated from the heap.
+  std::size_t in_use = 0;       // Bytes of those holding live values.
+  std::size_t allocations = 0;  // Allocations since the current step began.
+
+  MemoryUsage& operator+=(const MemoryUsage& that) {
+    reserved += that.reserved;
+    in_use += that.in_use;
+    allocations += that.allocations;
+    return *this;
+  }
+};
+
+struct NamedMemoryUsage final {
+  std::string_view name;  // Outlives the usage, e.g. a `TypeRecord::name`.
+  MemoryUsage usage;
+};
+
+// Tallies the heap allocations of one subsystem, as reported by its
+// `CountingAllocator`s. What of it is in use only the subsystem knows. Not
+// thread safe: an account belongs to one world, which steps on one thread.
+class MemoryAccount final {
+ public:
+  DECLARE_COPY_DELETE(MemoryAccount);
+
+  MemoryAccount() = default;
+
+  void allocated(std::size_t bytes) {
+    reserved_ += bytes;
+    allocations_++;
+  }
+  void deallocated(std::size_t bytes) { reserved_ -= bytes; }
+
+  // Starts counting allocations afresh.
+  void begin_step() { step_allocations_ = allocations_; }
+
+  std::size_t reserved() const { return reserved_; }
+  std::size_t allocations() const { return allocations_ - step_allocations_; }
+
+ private:
+  std::size_t reserved_ = 0;
+  std::size_t allocations_ = 0;
+  std::size_t step_allocations_ = 0;
+};
+
+// Allocates as `std::allocator` does and reports each allocation to an account,
+// which must outlive every container using it. Containers holding an account
+// and allocating from it are neither copyable nor movable, as the account is
+// not, which keeps them from outliving it.
+template <typename Type>
+class CountingAllocator {
+ public:
+  using value_type = Type;
+
+  explicit CountingAllocator(MemoryAccount* account) : account_{account} {}
+  template <typename ThatType>
+  CountingAllocator(const CountingAllocator<ThatType>& that)
+      : account_{that.account()} {}
+
+  Type* allocate(std::size_t count) {
+    Type* pointer = std::allocator<Type>{}.allocate(count);
+    account_->allocated(count * sizeof(Type));
+    return pointer;
+  }
+
+  void deallocate(Type* pointer, std::size_t count) {
+    account_->deallocated(count * sizeof(Type));
+    std::allocator<Type>{}.deallocate(pointer, count);
+  }
+
+  MemoryAccount* account() const { return account_; }
+
+  template <typename ThatType>
+  bool operator==(const CountingAllocator<ThatType>& that) const {
+    return account_ == that.account();
+  }
+
+ private:
+  MemoryAccount* account_;
+};
+
+// A sequence whose values never move, as in a `std::deque`, but grown by blocks
+// of `BLOCK_SIZE` values rather than of a few hundred bytes. Filling it with a
+// million values allocates a few hundred times rather than a few hundred
+// thousand, and each block is contiguous, so it can be filled and walked at
+// memory speed. Clearing keeps the blocks, so refilling it to the same size, as
+// on restore, allocates nothing.
+template <typename Type, typename AllocatorType = std::allocator<Type>>
+class BlockVector final {
+  template <bool IsConst>
+  class Iterator;
+
+ public:
+  DECLARE_COPY_DELETE(BlockVector);
+  DECLARE_MOVE_DELETE(BlockVector);
+
+  // A power of two, so that finding a value by index is a shift and a mask.
+  static constexpr std::size_t BLOCK_SIZE =
+      std::bit_floor(std::max<std::size_t>(64 * 1024 / sizeof(Type), 1));
+
+  using value_type = Type;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  explicit BlockVector(const AllocatorType& allocator = AllocatorType{})
+      : allocator_{allocator}, blocks_{BlockAllocatorType{allocator}} {}
+
+  ~BlockVector() {
+    clear();
+    for (Type* block : blocks_) {
+      allocator_.deallocate(block, BLOCK_SIZE);
+    }
+  }
+
+  template <typename... ArgumentTypes>
+  Type& emplace_back(ArgumentTypes&&... arguments) {
+    if (size_ == blocks_.size() * BLOCK_SIZE) {
+      blocks_.push_back(allocator_.allocate(BLOCK_SIZE));
+    }
+    Type* value = std::construct_at(
+        &(*this)[size_], std::forward<ArgumentTypes>(arguments)...);
+    size_++;
+    return *value;
+  }
+
+  // Allocates the blocks for `count` values up front.
+  void reserve(std::size_t count) {
+    const std::size_t block_count = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    blocks_.reserve(block_count);
+    while (blocks_.size() < block_count) {
+      blocks_.push_back(allocator_.allocate(BLOCK_SIZE));
+    }
+  }
+
+  // Destroys the values but keeps their blocks.
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<Type>) {
+      for_each_block([](std::span<Type> values) {
+        std::destroy(values.begin(), values.end());
+      });
+    }
+    size_ = 0;
+  }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  Type& operator[](std::size_t index) {
+    return blocks_[index / BLOCK_SIZE][index % BLOCK_SIZE];
+  }
+  const Type& operator[](std::size_t index) const {
+    return blocks_[index / BLOCK_SIZE][index % BLOCK_SIZE];
+  }
+
+  iterator begin() { return {blocks_.data(), 0}; }
+  iterator end() { return {blocks_.data(), size_}; }
+  const_iterator begin() const { return {blocks_.data(), 0}; }
+  const_iterator end() const { return {blocks_.data(), size_}; }
+
+  // Calls `visit(values)` with the values of each block in turn, for loops
+  // that run faster over a contiguous span than value by value.
+  template <typename VisitorType>
+  void for_each_block(VisitorType&& visit) {
+    for (std::size_t begin = 0; begin < size_; begin += BLOCK_SIZE) {
+      visit(std::span<Type>{blocks_[begin / BLOCK_SIZE],
+                            std::min(BLOCK_SIZE, size_ - begin)});
+    }
+  }
+  template <typename VisitorType>
+  void for_each_block(VisitorType&& visit) const {
+    for (std::size_t begin = 0; begin < size_; begin += BLOCK_SIZE) {
+      visit(std::span<const Type>{blocks_[begin / BLOCK_SIZE],
+                                  std::min(BLOCK_SIZE, size_ - begin)});
+    }
+  }
+
+ private:
+  using BlockAllocatorType = typename std::allocator_traits<
+      AllocatorType>::template rebind_alloc<Type*>;
+
+  template <bool IsConst>
+  class Iterator final {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = Type;
+    using reference = std::conditional_t<IsConst, const Type&, Type&>;
+    using pointer = std::conditional_t<IsConst, const Type*, Type*>;
+
+    Iterator() = default;
+    Iterator(Type* const* blocks, std::size_t index)
+        : blocks_{blocks}, index_{index} {}
+
+    reference operator*() const {
+      return blocks_[index_ / BLOCK_SIZE][index_ % BLOCK_SIZE];
+    }
+    pointer operator->() const { return &**this; }
+
+    Iterator& operator++() {
+      index_++;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator before = *this;
+      index_++;
+      return before;
+    }
+
+    bool operator==(const Iterator& that) const {
+      return index_ == that.index_;
+    }
+
+   private:
+    Type* const* blocks_ = nullptr;
+    std::size_t index_ = 0;
+  };
+
+  AllocatorType allocator_;
+  std::vector<Type*, BlockAllocatorType> blocks_;
+  std::size_t size_ = 0;
+};
+
+}  // namespace simon
@@ -0,0 +1,149 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "base/memory.hpp"
+
+#include <cstdint>
+#include <map>
+#include <span>
+#include <vector>
+
+#include "base/testing.hpp"
+
+namespace simon {
+
+TEST_CASE("CountingAllocator") {
+  MemoryAccount account;
+  CountingAllocator<std::int64_t> allocator{&account};
+
+  SECTION("ShouldCountBytesReserved") {
+    // Under Test.
+    std::vector<std::int64_t, CountingAllocator<std::int64_t>> values{allocator};
+    values.reserve(8);
+
+    // Postconditions.
+    REQUIRE(account.reserved() == 8 * sizeof(std::int64_t));
+    REQUIRE(account.allocations() == 1);
+  }
+
+  SECTION("ShouldReturnBytesOnDeallocation") {
+    // Under Test.
+    {
+      std::vector<std::int64_t, CountingAllocator<std::int64_t>> values{allocator};
+      values.assign(100, 0);
+    }
+
+    // Postconditions.
+    REQUIRE(account.reserved() == 0);
+  }
+
+  SECTION("ShouldCountNodesOfRebindingContainers") {
+    // Preconditions.
+    using Pair = std::pair<const int, int>;
+    std::map<int, int, std::less<int>, CountingAllocator<Pair>> values{
+        CountingAllocator<Pair>{allocator}};
+
+    // Under Test.
+    values[1] = 1;
+    values[2] = 2;
+
+    // Postconditions.
+    REQUIRE(account.reserved() >= 2 * sizeof(Pair));
+    REQUIRE(account.allocations() == 2);
+  }
+
+  SECTION("ShouldCountAllocationsSinceStepBegan") {
+    // Preconditions.
+    std::vector<std::int64_t, CountingAllocator<std::int64_t>> values{allocator};
+    values.reserve(1);
+
+    // Under Test.
+    account.begin_step();
+    values.reserve(2);
+
+    // Postconditions.
+    REQUIRE(account.allocations() == 1);
+    REQUIRE(account.reserved() == 2 * sizeof(std::int64_t));
+  }
+}
+
+TEST_CASE("BlockVector") {
+  MemoryAccount account;
+  using Values = BlockVector<std::int64_t, CountingAllocator<std::int64_t>>;
+  constexpr std::size_t COUNT = 3 * Values::BLOCK_SIZE + 1;
+  Values values{CountingAllocator<std::int64_t>{&account}};
+
+  SECTION("ShouldKeepAddressesAsItGrows") {
+    // Preconditions.
+    const std::int64_t* first = &values.emplace_back(0);
+
+    // Under Test.
+    for (std::size_t i = 1; i < COUNT; ++i) {
+      values.emplace_back(static_cast<std::int64_t>(i));
+    }
+
+    // Postconditions.
+    REQUIRE(values.size() == COUNT);
+    REQUIRE(&values[0] == first);
+    REQUIRE(values[COUNT - 1] == static_cast<std::int64_t>(COUNT - 1));
+  }
+
+  SECTION("ShouldVisitValuesInOrder") {
+    // Preconditions.
+    for (std::size_t i = 0; i < COUNT; ++i) {
+      values.emplace_back(static_cast<std::int64_t>(i));
+    }
+
+    // Under Test.
+    std::vector<std::int64_t> visited{values.begin(), values.end()};
+    std::size_t block_count = 0;
+    std::int64_t expected = 0;
+    bool blocks_in_order = true;
+    values.for_each_block([&](std::span<std::int64_t> block) {
+      block_count++;
+      for (auto value : block) {
+        blocks_in_order &= value == expected++;
+      }
+    });
+
+    // Postconditions.
+    REQUIRE(visited.size() == COUNT);
+    REQUIRE(visited.back() == static_cast<std::int64_t>(COUNT - 1));
+    REQUIRE(block_count == 4);
+    REQUIRE(blocks_in_order);
+    REQUIRE(expected == static_cast<std::int64_t>(COUNT));
+  }
+
+  SECTION("ShouldRefillWithoutAllocatingOnceCleared") {
+    // Preconditions.
+    values.reserve(COUNT);
+    std::size_t reserved = account.reserved();
+
+    // Under Test.
+    for (std::size_t i = 0; i < COUNT; ++i) {
+      values.emplace_back(0);
+    }
+    values.clear();
+    account.begin_step();
+    for (std::size_t i = 0; i < COUNT; ++i) {
+      values.emplace_back(0);
+    }
+
+    // Postconditions.
+    REQUIRE(reserved >= COUNT * sizeof(std::int64_t));
+    REQUIRE(account.reserved() == reserved);
+    REQUIRE(account.allocations() == 0);
+  }
+
+  SECTION("ShouldReturnBlocksOnDestruction") {
+    // Under Test.
+    {
+      Values scoped{CountingAllocator<std::int64_t>{&account}};
+      scoped.reserve(COUNT);
+    }
+
+    // Postconditions.
+    REQUIRE(account.reserved() == 0);
+  }
+}
+
+}  // namespace simon
@@ -1,8 +1,21 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <ostream>
 #include <source_location>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include "base/core.hpp"
 
@@ -15,13 +28,207 @@ class StatusKindDomainInterface;
 class StatusDomainInterface;
 class StatusDetached;
 class Status;
+class CompactStatus;
 
+// Condition messages are fixed text, so that a domain's table of them can be
+// `constexpr` and its kinds' messages known at compile time.
 struct StatusConditionEntry final {
-  std::string message;
+  std::string_view message;
 };
 
+// The text of a string literal, e.g. `StatusLiteral{"overflow"}`. Immediate,
+// so that only arrays of static storage are accepted: a buffer filled at run
+// time is a compile error rather than a dangling view.
+struct StatusLiteral final {
+  template <std::size_t N>
+  consteval StatusLiteral(const char (&literal)[N]) : text{literal, N - 1} {}
+
+  std::string_view text;
+};
+
+//==============================================================================
+// An incident message that costs nothing to raise unless it must own a string:
+// string literals are kept by address, and `lazy_format` captures a format
+// string and its arguments inline, formatting them only when the message is
+// first read. Any other text is copied.
+//
+class StatusMessage final {
+ public:
+  static constexpr std::size_t INLINE_ARGUMENTS_SIZE = 32;
+
+  StatusMessage() = default;
+  ~StatusMessage() = default;
+
+  // Interned: literals live for the whole program, so only their address is
+  // kept. Immediate, as `StatusLiteral` is, so that a constant array that is
+  // not a constant expression, e.g. a local one, is a compile error rather
+  // than a dangling view.
+  template <std::size_t N>
+  consteval StatusMessage(const char (&literal)[N])
+      : state_{State::LITERAL}, text_{literal, N - 1} {}
+
+  constexpr StatusMessage(StatusLiteral literal)
+      : state_{State::LITERAL}, text_{literal.text} {}
+
+  // Copied up to the first NUL, and no further than the buffer.
+  template <std::size_t N>
+  StatusMessage(char (&buffer)[N])
+      : StatusMessage{
+            std::string_view{buffer, std::find(buffer, buffer + N, '\0')}} {}
+
+  // Copied. A template taking the pointer as is, so that arrays, which would
+  // decay to it as well as bind to the overloads above, are not taken here.
+  template <typename PointerType>
+    requires std::is_same_v<std::remove_cvref_t<PointerType>, const char *> ||
+             std::is_same_v<std::remove_cvref_t<PointerType>, char *>
+  StatusMessage(PointerType &&message)
+      : StatusMessage{std::string_view{message}} {}
+
+  StatusMessage(std::string_view message)
+      : StatusMessage{std::string{message}} {}
+
+  StatusMessage(std::string message)
+      : state_{State::FORMATTED}, formatted_{std::move(message)} {}
+
+  StatusMessage(const StatusMessage &that) { *this = that; }
+  StatusMessage(StatusMessage &&that) noexcept { *this = std::move(that); }
+
+  StatusMessage &operator=(const StatusMessage &that) {
+    if (assign(that)) {
+      formatted_ = that.formatted_;
+    } else {
+      formatted_.reset();
+    }
+    return *this;
+  }
+
+  StatusMessage &operator=(StatusMessage &&that) noexcept {
+    if (assign(that)) {
+      formatted_ = std::move(that.formatted_);
+    } else {
+      formatted_.reset();
+    }
+    return *this;
+  }
+
+  std::string_view view() const noexcept {
+    State state = state_.load(std::memory_order_acquire);
+    if (state == State::LAZY || state == State::FORMATTING) [[unlikely]] {
+      state = format_once();
+    }
+    if (state == State::LITERAL) {
+      return text_;
+    }
+    return formatted_ ? std::string_view{*formatted_} : std::string_view{};
+  }
+
+ private:
+  enum class State : std::uint8_t {
+    EMPTY,
+    LITERAL,
+    LAZY,
+    FORMATTING,
+    FORMATTED,
+  };
+
+  using FormatFunction = void (*)(std::string_view, std::byte const *,
+                                  std::string *);
+
+  template <typename ArgumentTuple>
+  StatusMessage(std::string_view format, ArgumentTuple const &arguments,
+                FormatFunction formatter) noexcept
+      : state_{State::LAZY}, text_{format}, formatter_{formatter} {
+    std::size_t offset = 0;
+    std::apply(
+        [this, &offset](auto const &...argument) {
+          ((std::memcpy(arguments_ + offset, &argument, sizeof(argument)),
+            offset += sizeof(argument)),
+           ...);
+        },
+        arguments);
+  }
+
+  // Copies everything but the formatted text, and returns whether that is
+  // final and should be copied too.
+  bool assign(StatusMessage const &that) noexcept {
+    State state = that.state_.load(std::memory_order_acquire);
+    if (state == State::FORMATTING) {
+      state = State::LAZY;  // Format again rather than wait.
+    }
+    state_.store(state, std::memory_order_relaxed);
+    text_ = that.text_;
+    formatter_ = that.formatter_;
+    std::memcpy(arguments_, that.arguments_, sizeof(arguments_));
+    return state == State::FORMATTED;
+  }
+
+  // The first reader formats; any others wait for it to finish. Should
+  // formatting throw, the message reads as its format string instead, which
+  // needs nothing allocated.
+  State format_once() const noexcept {
+    State state = State::LAZY;
+    if (state_.compare_exchange_strong(state, State::FORMATTING,
+                                       std::memory_order_acquire)) {
+      state = State::FORMATTED;
+      try {
+        formatter_(text_, arguments_, &formatted_.emplace());
+      } catch (...) {
+        formatted_.reset();
+        state = State::LITERAL;
+      }
+      state_.store(state, std::memory_order_release);
+      return state;
+    }
+    while (state == State::FORMATTING) {
+      state = state_.load(std::memory_order_acquire);
+    }
+    return state;
+  }
+
+  mutable std::atomic<State> state_ = State::EMPTY;
+  std::string_view text_;  // The literal, or the lazy format string.
+  // Optional, so that a literal message holds no string and can be made at
+  // compile time.
+  mutable std::optional<std::string> formatted_;
+  FormatFunction formatter_ = nullptr;
+  alignas(std::max_align_t) std::byte arguments_[INLINE_ARGUMENTS_SIZE] = {};
+
+  template <typename... ArgumentTypes>
+  friend StatusMessage lazy_format(std::format_string<ArgumentTypes...>,
+                                   ArgumentTypes...) noexcept;
+};
+
+// Arguments are captured by value, so only plain numbers are accepted; format
+// anything that refers to other storage eagerly instead.
+template <typename... ArgumentTypes>
+StatusMessage lazy_format(std::format_string<ArgumentTypes...> format,
+                          ArgumentTypes... arguments) noexcept {
+  static_assert((std::is_arithmetic_v<ArgumentTypes> && ...),
+                "Lazily formatted arguments must be numbers");
+  static_assert((sizeof(ArgumentTypes) + ... + 0) <=
+                    StatusMessage::INLINE_ARGUMENTS_SIZE,
+                "Lazily formatted arguments must fit inline");
+
+  auto formatter = [](std::string_view format, std::byte const *bytes,
+                      std::string *formatted) {
+    std::tuple<ArgumentTypes...> arguments;
+    std::size_t offset = 0;
+    std::apply(
+        [&](auto &...argument) {
+          ((std::memcpy(&argument, bytes + offset, sizeof(argument)),
+            offset += sizeof(argument)),
+           ...);
+          *formatted = std::vformat(format, std::make_format_args(argument...));
+        },
+        arguments);
+  };
+
+  return StatusMessage{format.get(), std::tuple<ArgumentTypes...>{arguments...},
+                       formatter};
+}
+
 struct StatusIncidentEntry final {
-  std::string message;
+  StatusMessage message;
   std::source_location location;
   int platform_error = 0;
 };
@@ -159,6 +366,23 @@ class StatusBaseInspectInterface {
 
   virtual int status_base_platform_error_of(
       StatusBase const *) const noexcept = 0;
+
+  // Everything recorded about the status's incident, including a message that
+  // is copied without being formatted where the domain allows.
+  virtual StatusIncidentEntry status_base_incident_of(
+      StatusBase const *status) const noexcept {
+    return StatusIncidentEntry{
+        .message = std::string{status_base_message_of(status)},
+        .location = status_base_location_of(status),
+        .platform_error = status_base_platform_error_of(status),
+    };
+  }
+
+  // True once the domain has reused the storage of the status's incident, so
+  // that its message, location and platform error describe a later incident.
+  virtual bool status_base_expired_of(StatusBase const *) const noexcept {
+    return false;
+  }
 };
 
 class StatusBaseBuilderInterface {
@@ -221,6 +445,9 @@ class StatusDomainBuilderBase : public StatusKindBuilderInterface,
       : domain_code_{domain_code, 0U, 0U}, name_{domain_name} {}
 
   std::string_view name() const noexcept { return name_; }
+  std::size_t domain_code() const noexcept {
+    return domain_code_.domain_bits();
+  }
 
   StatusCode make_status_kind_code(
       std::size_t condition_code) const noexcept final {
@@ -249,6 +476,68 @@ StatusDetached make_status_detached(  //
     StatusCode, StatusDomainInterface const *) noexcept;
 constexpr StatusKind make_status_kind(  //
     StatusCode, StatusKindInspectInterface const *) noexcept;
+
+// Stands in for a domain that is gone or was never registered, so that a
+// `CompactStatus` outliving its domain still reads safely, as expired.
+class UnknownStatusDomain final : public StatusDomainInterface {
+ public:
+  std::string_view status_base_message_of(
+      StatusBase const *) const noexcept override {
+    return MESSAGE;
+  }
+
+  std::source_location status_base_location_of(
+      StatusBase const *) const noexcept override {
+    return {};
+  }
+
+  int status_base_platform_error_of(
+      StatusBase const *) const noexcept override {
+    return 0;
+  }
+
+  bool status_base_expired_of(StatusBase const *) const noexcept override {
+    return true;
+  }
+
+  constexpr std::string_view status_kind_message_of(
+      StatusKind const *) const noexcept override {
+    return MESSAGE;
+  }
+
+ private:
+  static constexpr std::string_view MESSAGE = "Unknown status domain";
+};
+
+inline const UnknownStatusDomain unknown_status_domain;
+
+// Every live domain, indexed by its domain code, so that a `CompactStatus` can
+// find its domain from its code alone.
+inline std::array<std::atomic<StatusDomainInterface const *>, 1u << 16>
+    status_domain_table;
+
+// Two live domains may not share a code: the table would find only one of them.
+inline void register_status_domain(std::size_t domain_code,
+                                   StatusDomainInterface const *domain) {
+  StatusDomainInterface const *registered = nullptr;
+  if (!status_domain_table[domain_code].compare_exchange_strong(
+          registered, domain, std::memory_order_acq_rel)) {
+    CHECK_PRECONDITION(registered == domain);
+  }
+}
+
+inline void unregister_status_domain(
+    std::size_t domain_code, StatusDomainInterface const *domain) noexcept {
+  // Leave the entry alone if another domain has since taken the code.
+  status_domain_table[domain_code].compare_exchange_strong(
+      domain, nullptr, std::memory_order_acq_rel);
+}
+
+inline StatusDomainInterface const *status_domain_of(StatusCode code) noexcept {
+  auto *domain =
+      status_domain_table[code.domain_bits()].load(std::memory_order_acquire);
+  return domain != nullptr ? domain : &unknown_status_domain;
+}
 }  // namespace impl
 
 constexpr std::size_t domain_code_of(StatusKind const *) noexcept;
@@ -359,17 +648,13 @@ class StatusDetached final : public StatusBase {
   StatusDetached() = delete;
   ~StatusDetached() = default;
 
-  std::string_view message() const noexcept { return entry_.message; }
+  std::string_view message() const noexcept { return entry_.message.view(); }
   std::source_location location() const noexcept { return entry_.location; }
   int platform_error() const noexcept { return entry_.platform_error; }
 
  private:
   explicit StatusDetached(StatusCode code, StatusDomainInterface const *domain)
-      : StatusBase{code} {
-    entry_.message = domain->status_base_message_of(this);
-    entry_.location = domain->status_base_location_of(this);
-    entry_.platform_error = domain->status_base_platform_error_of(this);
-  }
+      : StatusBase{code}, entry_{domain->status_base_incident_of(this)} {}
 
   StatusIncidentEntry entry_;
 
@@ -404,6 +689,10 @@ class Status final : public StatusBase {
     return domain_->status_base_platform_error_of(this);
   }
 
+  bool expired() const noexcept {
+    return domain_->status_base_expired_of(this);
+  }
+
   StatusKind kind() const noexcept {
     return impl::make_status_kind(status_code_, domain_);
   }
@@ -420,6 +709,8 @@ class Status final : public StatusBase {
     return *this == that || domain_->has_equivalent_condition_of(this, &that);
   }
 
+  CompactStatus compact() const noexcept;
+
  private:
   explicit Status(StatusCode code, StatusDomainInterface const *domain)
       : StatusBase{code}, domain_{domain} {}
@@ -435,6 +726,255 @@ class Status final : public StatusBase {
   }
 };
 
+//==============================================================================
+// A `Status` that fits in one register: only the code, with the domain looked
+// up by the code's domain bits. Compares and converts exactly like the
+// `Status` it was made from, provided its domain is still alive. Once it is
+// gone, the status reads as expired, with no location and a placeholder message.
+//
+class CompactStatus final : public StatusBase {
+ public:
+  DECLARE_COPY_DEFAULT(CompactStatus);
+  DECLARE_MOVE_DEFAULT(CompactStatus);
+
+  CompactStatus() = delete;
+  ~CompactStatus() = default;
+
+  std::string_view message() const noexcept {
+    return domain()->status_base_message_of(this);
+  }
+  std::source_location location() const noexcept {
+    return domain()->status_base_location_of(this);
+  }
+
+  int platform_error() const noexcept {
+    return domain()->status_base_platform_error_of(this);
+  }
+
+  bool expired() const noexcept {
+    return domain()->status_base_expired_of(this);
+  }
+
+  StatusKind kind() const noexcept {
+    return impl::make_status_kind(status_code_, domain());
+  }
+
+  StatusDetached detach_copy() const noexcept {
+    return impl::make_status_detached(status_code_, domain());
+  }
+
+  Status expand() const noexcept {
+    return impl::make_status(status_code_, domain());
+  }
+
+  bool has_equivalent_condition_as(CompactStatus that) const noexcept {
+    return *this == that || domain()->has_equivalent_condition_of(this, &that);
+  }
+
+  bool has_equivalent_condition_as(Status that) const noexcept {
+    return *this == that || domain()->has_equivalent_condition_of(this, &that);
+  }
+
+  bool has_equivalent_condition_as(StatusKind that) const noexcept {
+    return *this == that || domain()->has_equivalent_condition_of(this, &that);
+  }
+
+ private:
+  explicit CompactStatus(StatusCode code) : StatusBase{code} {}
+
+  StatusDomainInterface const *domain() const noexcept {
+    return impl::status_domain_of(status_code_);
+  }
+
+  friend class Status;
+
+  friend std::ostream &operator<<(std::ostream &out,
+                                  CompactStatus self) noexcept {
+    out << self.message();
+    return out;
+  }
+};
+
+inline CompactStatus Status::compact() const noexcept {
+  return CompactStatus{status_code_};
+}
+
+//==============================================================================
+// Either a value or the status of why there is none, for functions that would
+// otherwise return a `Status` and write their result through an `Out`. The
+// failure is held compactly, so a `Result` of a trivially copyable value of up
+// to 8 bytes is 16 bytes and comes back in registers.
+//
+template <typename ValueType>
+class Result;
+
+namespace impl {
+template <typename Type>
+inline constexpr bool is_result_v = false;
+template <typename ValueType>
+inline constexpr bool is_result_v<Result<ValueType>> = true;
+}  // namespace impl
+
+template <typename ValueType>
+class [[nodiscard]] Result final {
+  static_assert(!std::is_reference_v<ValueType>);
+  static_assert(!std::is_base_of_v<StatusBase, std::remove_cv_t<ValueType>>);
+  static_assert(std::is_nothrow_move_constructible_v<ValueType>);
+
+ public:
+  using value_type = ValueType;
+
+  Result(ValueType const &value) noexcept(
+      std::is_nothrow_copy_constructible_v<ValueType>)
+      : value_{value}, has_value_{true} {}
+  Result(ValueType &&value) noexcept
+      : value_{std::move(value)}, has_value_{true} {}
+  Result(Status status) noexcept
+      : status_{status.compact()}, has_value_{false} {}
+  Result(CompactStatus status) noexcept : status_{status}, has_value_{false} {}
+
+  Result(Result const &)
+    requires std::is_trivially_copy_constructible_v<ValueType>
+  = default;
+  Result(Result const &that) noexcept(
+      std::is_nothrow_copy_constructible_v<ValueType>)
+      : has_value_{that.has_value_} {
+    construct_from(that);
+  }
+
+  Result(Result &&)
+    requires std::is_trivially_move_constructible_v<ValueType>
+  = default;
+  Result(Result &&that) noexcept : has_value_{that.has_value_} {
+    construct_from(std::move(that));
+  }
+
+  Result &operator=(Result const &)
+    requires std::is_trivially_copyable_v<ValueType>
+  = default;
+  Result &operator=(Result const &that) {
+    if (this != &that) {
+      Result copy{that};
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  Result &operator=(Result &&)
+    requires std::is_trivially_copyable_v<ValueType>
+  = default;
+  Result &operator=(Result &&that) noexcept {
+    if (this != &that) {
+      destroy();
+      has_value_ = that.has_value_;
+      construct_from(std::move(that));
+    }
+    return *this;
+  }
+
+  ~Result()
+    requires std::is_trivially_destructible_v<ValueType>
+  = default;
+  ~Result() { destroy(); }
+
+  bool has_value() const noexcept { return has_value_; }
+  explicit operator bool() const noexcept { return has_value_; }
+
+  ValueType &value() & {
+    CHECK_PRECONDITION(has_value_);
+    return value_;
+  }
+  ValueType const &value() const & {
+    CHECK_PRECONDITION(has_value_);
+    return value_;
+  }
+  ValueType &&value() && {
+    CHECK_PRECONDITION(has_value_);
+    return std::move(value_);
+  }
+
+  template <typename OtherType>
+  ValueType value_or(OtherType &&other) const & {
+    if (has_value_) [[likely]] {
+      return value_;
+    }
+    return static_cast<ValueType>(std::forward<OtherType>(other));
+  }
+
+  Status status() const {
+    CHECK_PRECONDITION(!has_value_);
+    return status_.expand();
+  }
+
+  // Calls `function` with the value, which must itself return a `Result`, or
+  // passes the status on.
+  template <typename FunctionType>
+  auto and_then(FunctionType &&function) const & {
+    using ResultType = std::remove_cvref_t<
+        std::invoke_result_t<FunctionType, ValueType const &>>;
+    static_assert(impl::is_result_v<ResultType>);
+    if (has_value_) [[likely]] {
+      return std::invoke(std::forward<FunctionType>(function), value_);
+    }
+    return ResultType{status_};
+  }
+  template <typename FunctionType>
+  auto and_then(FunctionType &&function) && {
+    using ResultType = std::remove_cvref_t<
+        std::invoke_result_t<FunctionType, ValueType &&>>;
+    static_assert(impl::is_result_v<ResultType>);
+    if (has_value_) [[likely]] {
+      return std::invoke(std::forward<FunctionType>(function),
+                         std::move(value_));
+    }
+    return ResultType{status_};
+  }
+
+  // Maps the value through `function`, or passes the status on.
+  template <typename FunctionType>
+  auto transform(FunctionType &&function) const & {
+    using ResultType = Result<std::remove_cv_t<
+        std::invoke_result_t<FunctionType, ValueType const &>>>;
+    if (has_value_) [[likely]] {
+      return ResultType{
+          std::invoke(std::forward<FunctionType>(function), value_)};
+    }
+    return ResultType{status_};
+  }
+  template <typename FunctionType>
+  auto transform(FunctionType &&function) && {
+    using ResultType = Result<
+        std::remove_cv_t<std::invoke_result_t<FunctionType, ValueType &&>>>;
+    if (has_value_) [[likely]] {
+      return ResultType{std::invoke(std::forward<FunctionType>(function),
+                                    std::move(value_))};
+    }
+    return ResultType{status_};
+  }
+
+ private:
+  template <typename ThatType>
+  void construct_from(ThatType &&that) {
+    if (has_value_) [[likely]] {
+      std::construct_at(&value_, std::forward<ThatType>(that).value_);
+    } else {
+      std::construct_at(&status_, that.status_);
+    }
+  }
+
+  void destroy() noexcept {
+    if (has_value_) {
+      std::destroy_at(&value_);
+    }
+  }
+
+  union {
+    ValueType value_;
+    CompactStatus status_;
+  };
+  bool has_value_;
+};
+
 //------------------------------------------------------------------------------
 //
 namespace impl {
@@ -489,7 +1029,7 @@ class EnumStatusKindConditionMixin {
   virtual StatusKind handle_watch_kind(
       ConditionEnumType condition) const noexcept = 0;
 
-  StatusKind do_watch_kind(                       //
+  constexpr StatusKind do_watch_kind(             //
       ConditionEnumType condition,                //
       StatusKindBuilderInterface const *builder,  //
       StatusKindInspectInterface const *domain) const noexcept {
@@ -503,6 +1043,8 @@ class EnumStatusKindConditionMixin {
     return conditions_[condition_code_of(kind)].message;
   }
 
+  // Defined by each domain's enum. Defining it `constexpr` in a header makes
+  // the messages of kinds from a `constexpr` domain constant expressions too.
   static const std::array<StatusConditionEntry, ConditionCount> conditions_;
 };
 
@@ -514,13 +1056,24 @@ class EnumStatusKindConditionMixin {
 // longer than the buffer might be expected to overlap, then `StatusDetached`
 // should be used instead, which keeps its own local copy.
 //
+// Incidents may be raised concurrently from any number of threads. Each raise
+// takes a ticket, which picks its slot and becomes its incident code, then
+// claims the slot by swapping the slot's state from idle to busy with that
+// ticket. Once a slot is reused, `Status::expired()` detects that the incident
+// it refers to has been overwritten. Reading an incident while another thread
+// overwrites it is still a race, as it was before the ring wrapped.
+//
 template <typename ConditionEnumType,  //
           std::size_t IncidentCountMax>
 class EnumStatusIncidentMixin {
+  static_assert(std::has_single_bit(IncidentCountMax) &&
+                    IncidentCountMax <= (1u << 16),
+                "Incident count must be a power of two that fits the code");
+
  public:
   Status raise_status(              //
       ConditionEnumType condition,  //
-      std::string message = {}) noexcept {
+      StatusMessage message = {}) noexcept {
     std::source_location location{};  // Empty.
     return handle_raise_incident(condition, StatusIncidentEntry{
                                                 .message = std::move(message),
@@ -531,7 +1084,7 @@ class EnumStatusIncidentMixin {
 
   Status raise_status_here(         //
       ConditionEnumType condition,  //
-      std::string message = {},     //
+      StatusMessage message = {},   //
       std::source_location location =
           std::source_location::current()) noexcept {
     return handle_raise_incident(condition, StatusIncidentEntry{
@@ -544,7 +1097,7 @@ class EnumStatusIncidentMixin {
   Status raise_error(               //
       ConditionEnumType condition,  //
       int platform_error,           //
-      std::string message = {}) noexcept {
+      StatusMessage message = {}) noexcept {
     std::source_location location{};  // Empty.
     return handle_raise_incident(condition,
                                  StatusIncidentEntry{
@@ -557,7 +1110,7 @@ class EnumStatusIncidentMixin {
   Status raise_error_here(          //
       ConditionEnumType condition,  //
       int platform_error,           //
-      std::string message = {},
+      StatusMessage message = {},
       std::source_location location =
           std::source_location::current()) noexcept {
     return handle_raise_incident(condition,
@@ -577,46 +1130,113 @@ class EnumStatusIncidentMixin {
       StatusIncidentEntry entry,                  //
       StatusBaseBuilderInterface const *builder,  //
       StatusDomainInterface const *domain) noexcept {
-    std::size_t current = next_incident_++;
-    next_incident_ %= incidents_.size();
-    incidents_[current] = std::move(entry);
+    std::uint64_t ticket = next_ticket_.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = slot_of(ticket);
+    std::uint64_t claimed = state_of(ticket);
+
+    std::uint64_t state = slot.state.load(std::memory_order_relaxed);
+    while (true) {
+      if (state & BUSY) {
+        // Another raise that wrapped onto this slot is still writing it.
+        state = slot.state.load(std::memory_order_relaxed);
+      } else if (state > claimed) {
+        break;  // A later raise already took the slot; ours is expired.
+      } else if (slot.state.compare_exchange_weak(state, claimed | BUSY,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed)) {
+        slot.entry = std::move(entry);
+        slot.state.store(claimed, std::memory_order_release);
+        break;
+      }
+    }
 
     auto condition_code = static_cast<std::size_t>(condition);
+    auto incident_code = static_cast<std::size_t>(ticket & INCIDENT_CODE_MASK);
     return impl::make_status(
-        builder->make_status_base_code(condition_code, current), domain);
+        builder->make_status_base_code(condition_code, incident_code), domain);
   }
 
   std::string_view status_base_message_of(
       StatusBase const *status) const noexcept {
-    return incidents_[incident_code_of(status)].message;
+    return slot_of(incident_code_of(status)).entry.message.view();
   }
 
   std::source_location status_base_location_of(
       StatusBase const *status) const noexcept {
-    return incidents_[incident_code_of(status)].location;
+    return slot_of(incident_code_of(status)).entry.location;
   }
 
   int status_base_platform_error_of(StatusBase const *status) const noexcept {
-    return incidents_[incident_code_of(status)].platform_error;
+    return slot_of(incident_code_of(status)).entry.platform_error;
+  }
+
+  StatusIncidentEntry status_base_incident_of(
+      StatusBase const *status) const noexcept {
+    return slot_of(incident_code_of(status)).entry;
+  }
+
+  bool status_base_expired_of(StatusBase const *status) const noexcept {
+    std::uint64_t incident_code = incident_code_of(status);
+    std::uint64_t state =
+        slot_of(incident_code).state.load(std::memory_order_acquire);
+    return (state & BUSY) || state == IDLE ||
+           (ticket_of(state) & INCIDENT_CODE_MASK) != incident_code;
   }
 
  private:
-  std::size_t next_incident_ = 0;
-  std::array<StatusIncidentEntry, IncidentCountMax> incidents_;
+  // Slot states hold the ticket of the incident written there, offset so that
+  // zero means never written, with the low bit set while it is being written.
+  static constexpr std::uint64_t IDLE = 0;
+  static constexpr std::uint64_t BUSY = 1;
+  static constexpr std::uint64_t INCIDENT_CODE_MASK = 0xFFFF;
+  static constexpr std::size_t CACHE_LINE = 64;
+
+  static constexpr std::uint64_t state_of(std::uint64_t ticket) noexcept {
+    return (ticket + 1) << 1;
+  }
+
+  static constexpr std::uint64_t ticket_of(std::uint64_t state) noexcept {
+    return (state >> 1) - 1;
+  }
+
+  struct alignas(CACHE_LINE) Slot final {
+    std::atomic<std::uint64_t> state = IDLE;
+    StatusIncidentEntry entry;
+  };
+
+  Slot &slot_of(std::uint64_t ticket) noexcept {
+    return slots_[ticket % IncidentCountMax];
+  }
+
+  Slot const &slot_of(std::uint64_t ticket) const noexcept {
+    return slots_[ticket % IncidentCountMax];
+  }
+
+  std::atomic<std::uint64_t> next_ticket_ = 0;
+  std::array<Slot, IncidentCountMax> slots_;
 };
 
 //==============================================================================
-// Kind-only enum-based domain type.
+// Kind-only enum-based domain type. It may be `constexpr`, and so may its kinds
+// and their messages. Watching a kind here does not dispatch, and the inspect
+// interface comes first so that a kind reaches it without a thunk: some
+// compilers cannot yet evaluate calls through thunks in constant expressions.
 //
 template <typename ConditionEnumType,  //
           std::size_t ConditionCount>
 class EnumStatusKindDomain
-    : public EnumStatusKindConditionMixin<ConditionEnumType, ConditionCount>,
-      public StatusKindInspectInterface,
+    : public StatusKindInspectInterface,
+      public EnumStatusKindConditionMixin<ConditionEnumType, ConditionCount>,
       public StatusKindBuilderBase {
  public:
   using StatusKindBuilderBase::StatusKindBuilderBase;
 
+  constexpr StatusKind watch_kind(ConditionEnumType condition) const noexcept {
+    return EnumStatusKindConditionMixin<ConditionEnumType,
+                                        ConditionCount>::do_watch_kind(  //
+        condition, this, this);
+  }
+
   constexpr std::string_view status_kind_message_of(
       StatusKind const *kind) const noexcept override {
     return EnumStatusKindConditionMixin<
@@ -626,9 +1246,7 @@ class EnumStatusKindDomain
  private:
   StatusKind handle_watch_kind(
       ConditionEnumType condition) const noexcept final {
-    return EnumStatusKindConditionMixin<ConditionEnumType,
-                                        ConditionCount>::do_watch_kind(  //
-        condition, this, this);
+    return watch_kind(condition);
   }
 };
 
@@ -646,7 +1264,16 @@ class EnumStatusDomain
       public EnumStatusKindConditionMixin<ConditionEnumType, ConditionCount>,
       public EnumStatusIncidentMixin<ConditionEnumType, IncidentCountMax> {
  public:
-  using StatusDomainBuilderBase::StatusDomainBuilderBase;
+  explicit EnumStatusDomain(std::size_t domain_code,
+                            std::string_view domain_name)
+      : StatusDomainBuilderBase{domain_code, domain_name} {
+    // The masked code, which unregistering and lookups use too.
+    impl::register_status_domain(this->domain_code(), this);
+  }
+
+  ~EnumStatusDomain() {
+    impl::unregister_status_domain(this->domain_code(), this);
+  }
 
   constexpr std::string_view status_kind_message_of(
       StatusKind const *kind) const noexcept override {
@@ -672,6 +1299,18 @@ class EnumStatusDomain
         status_base_platform_error_of(status);
   }
 
+  StatusIncidentEntry status_base_incident_of(
+      StatusBase const *status) const noexcept override {
+    return EnumStatusIncidentMixin<ConditionEnumType, IncidentCountMax>::
+        status_base_incident_of(status);
+  }
+
+  bool status_base_expired_of(
+      StatusBase const *status) const noexcept override {
+    return EnumStatusIncidentMixin<ConditionEnumType, IncidentCountMax>::
+        status_base_expired_of(status);
+  }
+
  private:
   StatusKind handle_watch_kind(
       ConditionEnumType condition) const noexcept final {
@@ -711,10 +1350,61 @@ thread_local_enum_status_domain() noexcept {
   return domain;
 }
 
+//==============================================================================
+// Inspects statuses and kinds of a domain whose type is known statically by
+// calling that type's own members directly, rather than dispatching through
+// `StatusDomainInterface`, so that the calls can inline into hot paths. The
+// domain must be of exactly `DomainType`, and the statuses must be its own.
+//
+template <typename DomainType>
+class StaticStatusDomain final {
+ public:
+  DECLARE_COPY_DEFAULT_CONSTEXPR(StaticStatusDomain);
+  DECLARE_MOVE_DEFAULT_CONSTEXPR(StaticStatusDomain);
+
+  StaticStatusDomain() = delete;
+  constexpr ~StaticStatusDomain() = default;
+
+  constexpr explicit StaticStatusDomain(DomainType const &domain) noexcept
+      : domain_{&domain} {}
+
+  constexpr std::string_view message_of(StatusKind kind) const noexcept {
+    return domain_->DomainType::status_kind_message_of(&kind);
+  }
+
+  std::string_view message_of(StatusBase status) const noexcept {
+    return domain_->DomainType::status_base_message_of(&status);
+  }
+
+  std::source_location location_of(StatusBase status) const noexcept {
+    return domain_->DomainType::status_base_location_of(&status);
+  }
+
+  int platform_error_of(StatusBase status) const noexcept {
+    return domain_->DomainType::status_base_platform_error_of(&status);
+  }
+
+  bool expired_of(StatusBase status) const noexcept {
+    return domain_->DomainType::status_base_expired_of(&status);
+  }
+
+ private:
+  DomainType const *domain_;
+};
+
+template <typename ConditionEnumType>
+auto static_status_domain() noexcept {
+  return StaticStatusDomain{
+      static_enum_status_domain<ConditionEnumType,
+                                static_cast<std::size_t>(
+                                    ConditionEnumType::COUNT)>()};
+}
+
 //------------------------------------------------------------------------------
 //
 template <typename ConditionEnumType>
-Status raise(ConditionEnumType condition, std::string message = {}) noexcept {
+Status raise(ConditionEnumType condition,
+             StatusMessage message = {}) noexcept {
   return static_enum_status_domain<ConditionEnumType,
                                    static_cast<std::size_t>(
                                        ConditionEnumType::COUNT)>()
@@ -723,7 +1413,7 @@ Status raise(ConditionEnumType condition, std::string message = {}) noexcept {
 
 template <typename ConditionEnumType>
 Status raise_here(
-    ConditionEnumType condition, std::string message = {},
+    ConditionEnumType condition, StatusMessage message = {},
     std::source_location location = std::source_location::current()) noexcept {
   return static_enum_status_domain<ConditionEnumType,
                                    static_cast<std::size_t>(
@@ -743,7 +1433,7 @@ StatusKind watch(ConditionEnumType condition) noexcept {
 //
 template <typename ConditionEnumType>
 Status raise_thread_local(ConditionEnumType condition,
-                          std::string message = {}) noexcept {
+                          StatusMessage message = {}) noexcept {
   return thread_local_enum_status_domain<ConditionEnumType,
                                          static_cast<std::size_t>(
                                              ConditionEnumType::COUNT)>()
@@ -752,7 +1442,7 @@ Status raise_thread_local(ConditionEnumType condition,
 
 template <typename ConditionEnumType>
 Status raise_here_thread_local(
-    ConditionEnumType condition, std::string message = {},
+    ConditionEnumType condition, StatusMessage message = {},
     std::source_location location = std::source_location::current()) noexcept {
   return thread_local_enum_status_domain<ConditionEnumType,
                                          static_cast<std::size_t>(
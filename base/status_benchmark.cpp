@@ -0,0 +1,93 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+// Compares returning a value plainly, through `Result`, and through an `Out`
+// argument, on a success path that is never inlined.
+// Run with `bazel run //base:status_benchmark`.
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "base/status.hpp"
+#include "base/testing.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+namespace simon {
+namespace {
+
+enum class Failure { NEGATIVE, COUNT };
+
+constexpr std::size_t VALUE_COUNT = 4096;
+
+double plain_root(double value) { return value * 0.5; }
+
+Result<double> result_root(double value) {
+  if (value < 0) [[unlikely]] {
+    return raise(Failure::NEGATIVE);
+  }
+  return value * 0.5;
+}
+
+// There is no success `Status` to return, so the flag stands in for one.
+bool out_root(double value, Out<double> root) {
+  if (value < 0) [[unlikely]] {
+    return false;
+  }
+  *root = value * 0.5;
+  return true;
+}
+
+// Called through pointers so that, as across translation units, callers cannot
+// see which registers a callee leaves alone.
+double (*volatile plain_root_call)(double) = plain_root;
+Result<double> (*volatile result_root_call)(double) = result_root;
+bool (*volatile out_root_call)(double, Out<double>) = out_root;
+
+}  // namespace
+
+template <>
+const std::array<StatusConditionEntry, 1>
+    EnumStatusKindConditionMixin<Failure, 1>::conditions_ = {
+        StatusConditionEntry{"NEGATIVE"},
+};
+
+TEST_CASE("ResultReturn") {
+  std::mt19937 generate{42};
+  std::uniform_real_distribution<double> uniform{0, 100};
+  std::vector<double> values(VALUE_COUNT);
+  for (auto &value : values) {
+    value = uniform(generate);
+  }
+
+  BENCHMARK("Plain") {
+    auto call = plain_root_call;
+    double sum = 0;
+    for (double value : values) {
+      sum += call(value);
+    }
+    return sum;
+  };
+
+  BENCHMARK("Result") {
+    auto call = result_root_call;
+    double sum = 0;
+    for (double value : values) {
+      sum += call(value).value_or(0);
+    }
+    return sum;
+  };
+
+  BENCHMARK("Out") {
+    auto call = out_root_call;
+    double sum = 0;
+    for (double value : values) {
+      double root = 0;
+      if (call(value, Out<double>{root})) {
+        sum += root;
+      }
+    }
+    return sum;
+  };
+}
+
+}  // namespace simon
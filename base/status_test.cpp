@@ -1,7 +1,11 @@
 #include "base/status.hpp"
 
 #include <functional>
+#include <optional>
 #include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "base/testing.hpp"
 
@@ -189,7 +193,7 @@ class QuarkKindDomain final
 };
 
 template <>
-const std::array<StatusConditionEntry, QUARK_CONDITION_COUNT>
+constexpr std::array<StatusConditionEntry, QUARK_CONDITION_COUNT>
     EnumStatusKindConditionMixin<Quark, QUARK_CONDITION_COUNT>::conditions_ = {
         StatusConditionEntry{"UP"},       //
         StatusConditionEntry{"DOWN"},     //
@@ -207,6 +211,84 @@ std::string message1 = "bark";
 constexpr int platform_error0 = -50;
 constexpr int platform_error1 = -42;
 
+TEST_CASE("StatusMessage") {
+  SECTION("ShouldBeEmptyByDefault") {
+    // Under Test.
+    StatusMessage message;
+
+    // Postconditions.
+    REQUIRE(message.view().empty());
+  }
+
+  SECTION("ShouldNotCopyInternedLiteral") {
+    // Preconditions.
+    StatusMessage message = "interned";
+
+    // Under Test.
+    StatusMessage copy = message;
+
+    // Postconditions.
+    REQUIRE(copy.view() == "interned");
+    REQUIRE(copy.view().data() == message.view().data());
+  }
+
+  SECTION("ShouldNotCopyTaggedLiteral") {
+    // Under Test.
+    StatusMessage message = StatusLiteral{"tagged"};
+    StatusMessage copy = message;
+
+    // Postconditions.
+    REQUIRE(copy.view() == "tagged");
+    REQUIRE(copy.view().data() == message.view().data());
+  }
+
+  SECTION("ShouldCopyBufferUpToNul") {
+    // Preconditions.
+    char buffer[16] = "buffered";
+
+    // Under Test.
+    StatusMessage message = buffer;
+    buffer[0] = 'X';
+
+    // Postconditions.
+    REQUIRE(message.view() == "buffered");
+  }
+
+  SECTION("ShouldCopyCharPointer") {
+    // Preconditions.
+    std::string text = "pointed";
+
+    // Under Test.
+    StatusMessage message = text.c_str();
+    text[0] = 'X';
+
+    // Postconditions.
+    REQUIRE(message.view() == "pointed");
+  }
+
+  SECTION("ShouldFormatLazilyOnRead") {
+    // Under Test.
+    StatusMessage message = lazy_format("{} of {}", 3, 4.5);
+
+    // Postconditions.
+    REQUIRE(message.view() == "3 of 4.5");
+    REQUIRE(message.view() == "3 of 4.5");
+  }
+
+  SECTION("ShouldFormatCopiesIndependently") {
+    // Preconditions.
+    StatusMessage message = lazy_format("{}", 42);
+
+    // Under Test.
+    StatusMessage copy = message;
+    StatusMessage moved = std::move(message);
+
+    // Postconditions.
+    REQUIRE(copy.view() == "42");
+    REQUIRE(moved.view() == "42");
+  }
+}
+
 TEST_CASE("EnumStatusDomain") {
   SECTION("ShouldNotFetchStatusLocationByDefaultWhenRaiseStatus") {
     // Under Test.
@@ -236,6 +318,17 @@ TEST_CASE("EnumStatusDomain") {
     REQUIRE(message.size() > 0u);
   }
 
+  SECTION("ShouldRaiseStatusWithCharPointerMessage") {
+    // Preconditions.
+    const char* text = message1.c_str();
+
+    // Under Test.
+    Status status = domain.raise_status(Quark::UP, text);
+
+    // Postconditions.
+    REQUIRE(status.message() == message1);
+  }
+
   SECTION("ShouldFetchStatusLocationOnDemandWhenRaiseStatusHere") {
     // Preconditions.
     Status status = domain.raise_status_here(Quark::UP);
@@ -317,6 +410,15 @@ TEST_CASE("Status") {
   // Under Test.
   StatusDetached detached = status.detach_copy();
 
+  SECTION("ShouldHaveSameLazilyFormattedMessageAsWhenRaised") {
+    // Under Test.
+    Status status = domain.raise_status(Quark::UP, lazy_format("{}", 7));
+
+    // Postconditions.
+    REQUIRE(status.message() == "7");
+    REQUIRE(status.detach_copy().message() == "7");
+  }
+
   SECTION("ShouldHaveSameMessageAsDetachedCopy") {
     // Postconditions.
     REQUIRE(detached.message() == status.message());
@@ -426,6 +528,218 @@ TEST_CASE("Status") {
   }
 }
 
+TEST_CASE("CompactStatus") {
+  SECTION("ShouldFitInOneRegister") {
+    // Postconditions.
+    STATIC_REQUIRE(sizeof(CompactStatus) == sizeof(std::uint64_t));
+    STATIC_REQUIRE(std::is_trivially_copyable_v<CompactStatus>);
+  }
+
+  // Preconditions.
+  Status status = domain.raise_error_here(  //
+      Quark::UP, platform_error0, message0, location0);
+
+  // Under Test.
+  CompactStatus compact = status.compact();
+
+  SECTION("ShouldHaveSameMessageLocationAndPlatformErrorAsStatus") {
+    // Postconditions.
+    REQUIRE(compact.message() == status.message());
+    REQUIRE(compact.location().line() == status.location().line());
+    REQUIRE(compact.platform_error() == status.platform_error());
+  }
+
+  SECTION("ShouldBeEqualToStatusItWasMadeFrom") {
+    // Postconditions.
+    REQUIRE(compact == status);
+    REQUIRE(compact.expand() == status);
+    REQUIRE(compact.kind() == status.kind());
+  }
+
+  SECTION("ShouldNotBeEqualToStatusWithDifferentIncident") {
+    // Under Test.
+    CompactStatus other = domain.raise_status(Quark::UP).compact();
+
+    // Postconditions.
+    REQUIRE(other != compact);
+    REQUIRE(other != status);
+  }
+
+  SECTION("ShouldBeEquivalentToStatusWithSameCondition") {
+    // Under Test.
+    Status other = domain.raise_status(Quark::UP);
+
+    // Postconditions.
+    REQUIRE(compact.has_equivalent_condition_as(other.kind()));
+    REQUIRE(compact.has_equivalent_condition_as(other) ==
+            status.has_equivalent_condition_as(other));
+    REQUIRE(compact.has_equivalent_condition_as(other.compact()) ==
+            status.has_equivalent_condition_as(other));
+  }
+
+  SECTION("ShouldNotBeEquivalentToStatusWithDifferentCondition") {
+    // Under Test.
+    Status other = domain.raise_status(Quark::DOWN);
+
+    // Postconditions.
+    REQUIRE(!compact.has_equivalent_condition_as(other));
+    REQUIRE(!compact.has_equivalent_condition_as(other.compact()));
+    REQUIRE(!compact.has_equivalent_condition_as(other.kind()));
+  }
+
+  SECTION("ShouldHaveSameMessageAsDetachedCopy") {
+    // Postconditions.
+    REQUIRE(compact.detach_copy().message() == status.message());
+  }
+
+  SECTION("ShouldResolveNoDomainAfterItsDomainIsDestroyed") {
+    // Preconditions.
+    StatusCode code;
+    code.set_domain_bits(4242u);
+    {
+      QuarkStatusDomain scoped{4242u, "scoped"};
+      REQUIRE(impl::status_domain_of(code) == &scoped);
+    }
+
+    // Postconditions.
+    REQUIRE(impl::status_domain_of(code) == &impl::unknown_status_domain);
+  }
+
+  SECTION("ShouldReadAsExpiredAfterItsDomainIsDestroyed") {
+    // Preconditions.
+    std::optional<QuarkStatusDomain> scoped{std::in_place, 4242u, "scoped"};
+    CompactStatus orphan =
+        scoped->raise_error_here(Quark::UP, platform_error0, message0)
+            .compact();
+
+    // Under Test.
+    scoped.reset();
+
+    // Postconditions.
+    REQUIRE(orphan.expired());
+    REQUIRE(orphan.message() == "Unknown status domain");
+    REQUIRE(orphan.platform_error() == 0);
+    REQUIRE(orphan.kind().message() == "Unknown status domain");
+    REQUIRE(orphan.expand().expired());
+    REQUIRE(!orphan.has_equivalent_condition_as(status));
+  }
+
+// Only the throwing contract levels report the clash instead of aborting.
+#if CONTRACT_LEVEL >= CONTRACT_LEVEL_THROW
+  SECTION("ShouldNotRegisterTwoDomainsWithSameCode") {
+    // Preconditions.
+    QuarkStatusDomain scoped{4242u, "scoped"};
+
+    // Postconditions.
+    REQUIRE_THROWS(QuarkStatusDomain{4242u, "clashing"});
+    StatusCode code;
+    code.set_domain_bits(4242u);
+    REQUIRE(impl::status_domain_of(code) == &scoped);
+  }
+#endif
+
+  SECTION("ShouldBeOutStreamable") {
+    // Preconditions.
+    std::stringstream ss;
+
+    // Under Test.
+    ss << compact;
+
+    // Postconditions.
+    REQUIRE(ss.str() == status.message());
+  }
+}
+
+Result<int> parse_digit(char c) {
+  if (c < '0' || c > '9') {
+    return domain.raise_status(Quark::DOWN, "not a digit");
+  }
+  return c - '0';
+}
+
+TEST_CASE("Result") {
+  SECTION("ShouldBeAsSmallAsValueAndCompactStatus") {
+    // Postconditions.
+    STATIC_REQUIRE(sizeof(Result<double>) == 2 * sizeof(std::uint64_t));
+    STATIC_REQUIRE(std::is_trivially_copyable_v<Result<double>>);
+    STATIC_REQUIRE(!std::is_trivially_copyable_v<Result<std::string>>);
+  }
+
+  SECTION("ShouldHaveValueWhenSucceeded") {
+    // Under Test.
+    Result<int> result = parse_digit('7');
+
+    // Postconditions.
+    REQUIRE(result.has_value());
+    REQUIRE(result.value() == 7);
+    REQUIRE(result.value_or(0) == 7);
+    // Only the throwing contract levels catch the wrong member being read.
+#if CONTRACT_LEVEL >= CONTRACT_LEVEL_THROW
+    REQUIRE_THROWS(result.status());
+#endif
+  }
+
+  SECTION("ShouldHaveStatusWhenFailed") {
+    // Under Test.
+    Result<int> result = parse_digit('x');
+
+    // Postconditions.
+    REQUIRE(!result);
+    REQUIRE(result.status().message() == "not a digit");
+    REQUIRE(result.status() == domain.watch_kind(Quark::DOWN));
+    REQUIRE(result.value_or(-1) == -1);
+    // Only the throwing contract levels catch the wrong member being read.
+#if CONTRACT_LEVEL >= CONTRACT_LEVEL_THROW
+    REQUIRE_THROWS(result.value());
+#endif
+  }
+
+  SECTION("ShouldChainOnlySuccessesThroughAndThen") {
+    // Preconditions.
+    auto twice = [](int digit) { return parse_digit(char('0' + 2 * digit)); };
+
+    // Under Test.
+    Result<int> chained = parse_digit('3').and_then(twice);
+    Result<int> overflowed = parse_digit('7').and_then(twice);
+    Result<int> failed = parse_digit('x').and_then(twice);
+
+    // Postconditions.
+    REQUIRE(chained.value() == 6);
+    REQUIRE(!overflowed);
+    REQUIRE(failed.status().message() == "not a digit");
+  }
+
+  SECTION("ShouldMapOnlySuccessesThroughTransform") {
+    // Preconditions.
+    auto to_string = [](int digit) { return std::to_string(digit); };
+
+    // Under Test.
+    Result<std::string> mapped = parse_digit('4').transform(to_string);
+    Result<std::string> failed = parse_digit('x').transform(to_string);
+
+    // Postconditions.
+    REQUIRE(mapped.value() == "4");
+    REQUIRE(failed.status() == domain.watch_kind(Quark::DOWN));
+  }
+
+  SECTION("ShouldCopyAndMoveNonTrivialValues") {
+    // Preconditions.
+    Result<std::string> result = std::string(64, 'x');
+    Result<std::string> failed = domain.raise_status(Quark::DOWN);
+
+    // Under Test.
+    Result<std::string> copy = result;
+    Result<std::string> moved = std::move(copy);
+    copy = failed;
+    failed = moved;
+
+    // Postconditions.
+    REQUIRE(moved.value() == std::string(64, 'x'));
+    REQUIRE(failed.value() == moved.value());
+    REQUIRE(copy.status() == domain.watch_kind(Quark::DOWN));
+  }
+}
+
 TEST_CASE("StatusKind") {
   StatusKind down = domain.watch_kind(Quark::DOWN);
   StatusKind up = domain.watch_kind(Quark::UP);
@@ -501,6 +815,69 @@ TEST_CASE("EnumStatusKindDomain") {
     // Postconditions.
     REQUIRE(name == "quark");
   }
+
+  SECTION("ShouldHaveConstexprKinds") {
+    // Postconditions.
+    STATIC_REQUIRE(StatusKindShouldHaveSameMessage());
+    STATIC_REQUIRE(StatusKindShouldCompareSame());
+    STATIC_REQUIRE(StatusKindShouldCompareDifferent());
+  }
+
+  SECTION("ShouldHaveConstexprMessagesThroughStaticDomain") {
+    // Preconditions.
+    constexpr StaticStatusDomain static_quarks{quarks};
+    constexpr StatusKind kind = quarks.watch_kind(Quark::STRANGE);
+
+    // Postconditions.
+    STATIC_REQUIRE(static_quarks.message_of(kind) == "STRANGE");
+  }
+}
+
+TEST_CASE("StaticStatusDomain") {
+  // Preconditions.
+  StaticStatusDomain static_domain{domain};
+  Status status = domain.raise_error_here(  //
+      Quark::TOP, platform_error0, message0, location0);
+
+  SECTION("ShouldResolveSameIncidentAsStatus") {
+    // Postconditions.
+    REQUIRE(static_domain.message_of(status) == status.message());
+    REQUIRE(static_domain.location_of(status).line() ==
+            status.location().line());
+    REQUIRE(static_domain.platform_error_of(status) ==
+            status.platform_error());
+    REQUIRE(static_domain.expired_of(status) == status.expired());
+  }
+
+  SECTION("ShouldResolveSameConditionAsKind") {
+    // Preconditions.
+    StatusKind kind = status.kind();
+
+    // Postconditions.
+    REQUIRE(static_domain.message_of(kind) == kind.message());
+  }
+
+  SECTION("ShouldCallDomainTypeOverrides") {
+    // Preconditions.
+    std::size_t message_of_incident = domain.message_of_incident;
+
+    // Under Test.
+    std::string_view message = static_domain.message_of(status);
+
+    // Postconditions.
+    REQUIRE(message == message0);
+    REQUIRE(domain.message_of_incident == message_of_incident + 1);
+  }
+
+  SECTION("ShouldResolveStatusesOfStaticEnumDomain") {
+    // Preconditions.
+    Status raised = raise(Quark::CHARM, "charmed");
+
+    // Postconditions.
+    REQUIRE(static_status_domain<Quark>().message_of(raised) == "charmed");
+    REQUIRE(static_status_domain<Quark>().message_of(raised.kind()) ==
+            "CHARM");
+  }
 }
 
 TEST_CASE("StaticEnumStatusDomain") {
@@ -545,6 +922,55 @@ TEST_CASE("StaticEnumStatusDomain") {
     REQUIRE(status.location().line() > 0u);
   }
 
+  SECTION("ShouldNotExpireUntilIncidentIsReused") {
+    // Preconditions.
+    Status status = raise(Quark::TOP, message0);
+
+    // Under Test.
+    bool expired_before = status.expired();
+    for (std::size_t i = 0; i < DEFAULT_INCIDENT_COUNT; ++i) {
+      raise(Quark::TOP, message1);
+    }
+
+    // Postconditions.
+    REQUIRE(!expired_before);
+    REQUIRE(status.expired());
+  }
+
+  SECTION("ShouldRaiseConcurrentlyFromManyThreads") {
+    // Preconditions.
+    constexpr std::size_t THREAD_COUNT = 8;
+    constexpr std::size_t RAISE_COUNT = 1000;
+    std::vector<std::vector<Status>> raised(THREAD_COUNT);
+
+    // Under Test.
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < THREAD_COUNT; ++t) {
+      threads.emplace_back([t, &raised] {
+        for (std::size_t i = 0; i < RAISE_COUNT; ++i) {
+          raised[t].push_back(
+              raise(Quark::TOP, std::to_string(t * RAISE_COUNT + i)));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // Postconditions.
+    std::size_t current = 0;
+    for (std::size_t t = 0; t < THREAD_COUNT; ++t) {
+      for (std::size_t i = 0; i < RAISE_COUNT; ++i) {
+        const Status& status = raised[t][i];
+        if (!status.expired()) {
+          current++;
+          REQUIRE(status.message() == std::to_string(t * RAISE_COUNT + i));
+        }
+      }
+    }
+    REQUIRE(current == DEFAULT_INCIDENT_COUNT);
+  }
+
   SECTION("ShouldWatchForCondition") {
     // Preconditions.
     Status status = raise(Quark::TOP);
@@ -584,6 +1010,16 @@ TEST_CASE("ThreadLocalEnumStatusDomain") {
     REQUIRE(status1.message() == message1);
   }
 
+  SECTION("ShouldExpirePreviousStatusWhenRaised") {
+    // Under Test.
+    Status status0 = raise_thread_local(Quark::TOP, message0);
+    Status status1 = raise_thread_local(Quark::TOP, message1);
+
+    // Postconditions.
+    REQUIRE(status0.expired());
+    REQUIRE(!status1.expired());
+  }
+
   SECTION("ShouldRaiseMultipleStatusHereWithSingleLocationPerThread") {
     // Under Test.
     Status status0 = raise_here_thread_local(Quark::TOP, message0, location0);
@@ -0,0 +1,133 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "base/test_report.hpp"
+
+#include <charconv>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <ostream>
+#include <string_view>
+
+namespace simon {
+namespace {
+void write_json_string(std::ostream& out, std::string_view text) {
+  out << '"';
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << std::format("\\u{:04x}", c);
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+// Reads a JSON string starting at its opening quote. Returns the position past
+// its closing quote, or npos if there is none or an escape is malformed.
+std::size_t read_json_string(std::string_view line,
+                             std::size_t begin,
+                             std::string* text) {
+  for (std::size_t i = begin + 1; i < line.size(); ++i) {
+    if (line[i] == '"') {
+      return i + 1;
+    }
+    if (line[i] == '\\' && ++i < line.size()) {
+      if (line[i] == 'u' && i + 4 < line.size()) {
+        const char* digits = line.data() + i + 1;
+        unsigned code = 0;
+        auto [end, error] = std::from_chars(digits, digits + 4, code, 16);
+        if (error != std::errc{} || end != digits + 4) {
+          return std::string_view::npos;
+        }
+        *text += static_cast<char>(code);
+        i += 4;
+        continue;
+      }
+    }
+    *text += line[i];
+  }
+  return std::string_view::npos;
+}
+}  // namespace
+
+bool write_test_report(const std::string& path, const TestTimings& timings) {
+  std::ofstream out{path};
+  out << "{\n  \"timings\": [";
+  const char* separator = "\n";
+  for (auto&& [name, timing] : timings) {
+    out << separator << "    {\"name\": ";
+    write_json_string(out, name);
+    out << ", \"kind\": ";
+    write_json_string(out, timing.kind);
+    out << ", \"seconds\": " << std::format("{}", timing.seconds) << '}';
+    separator = ",\n";
+  }
+  out << "\n  ]\n}\n";
+  return static_cast<bool>(out.flush());
+}
+
+TestTimings read_test_report(const std::string& path) {
+  constexpr std::string_view name_key = "\"name\": ";
+  constexpr std::string_view kind_key = "\"kind\": ";
+  constexpr std::string_view seconds_key = "\"seconds\": ";
+
+  TestTimings timings;
+  std::ifstream in{path};
+  for (std::string line; std::getline(in, line);) {
+    auto name_at = line.find(name_key);
+    auto kind_at = line.find(kind_key);
+    auto seconds_at = line.find(seconds_key);
+    if (name_at == std::string::npos || kind_at == std::string::npos ||
+        seconds_at == std::string::npos) {
+      continue;
+    }
+    std::string name;
+    TestTiming timing;
+    if (read_json_string(line, name_at + name_key.size(), &name) ==
+            std::string_view::npos ||
+        read_json_string(line, kind_at + kind_key.size(), &timing.kind) ==
+            std::string_view::npos) {
+      continue;
+    }
+    timing.seconds =
+        std::strtod(line.c_str() + seconds_at + seconds_key.size(), nullptr);
+    timings.emplace(std::move(name), std::move(timing));
+  }
+  return timings;
+}
+
+std::vector<TestRegression> find_regressions(const TestTimings& timings,
+                                             const TestTimings& baseline,
+                                             double threshold) {
+  std::vector<TestRegression> regressions;
+  for (auto&& [name, timing] : timings) {
+    auto found = baseline.find(name);
+    if (found == baseline.end() || found->second.kind != timing.kind ||
+        found->second.seconds < MIN_COMPARED_SECONDS) {
+      continue;
+    }
+    TestRegression regression{name, timing.seconds, found->second.seconds};
+    if (regression.change() > threshold) {
+      regressions.push_back(std::move(regression));
+    }
+  }
+  return regressions;
+}
+
+std::string format_seconds(double seconds) {
+  if (seconds < 1e-6) {
+    return std::format("{:.1f} ns", seconds * 1e9);
+  }
+  if (seconds < 1e-3) {
+    return std::format("{:.1f} us", seconds * 1e6);
+  }
+  if (seconds < 1) {
+    return std::format("{:.1f} ms", seconds * 1e3);
+  }
+  return std::format("{:.2f} s", seconds);
+}
+
+}  // namespace simon
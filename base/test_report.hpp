@@ -0,0 +1,50 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace simon {
+
+// What a timing measures: a whole test case, one section of it summed over
+// every run through it, or the mean of a benchmark's samples.
+struct TestTiming final {
+  std::string kind;
+  double seconds = 0;
+};
+
+// By path of test case, sections and benchmark, in a stable order.
+using TestTimings = std::map<std::string, TestTiming>;
+
+// Timings shorter than this are mostly noise, so they are not compared.
+constexpr double MIN_COMPARED_SECONDS = 1e-3;
+
+struct TestRegression final {
+  std::string name;
+  double seconds = 0;
+  double baseline_seconds = 0;
+
+  // Slowdown over the baseline, as a fraction.
+  double change() const { return seconds / baseline_seconds - 1; }
+};
+
+// Writes timings as JSON, one per line, so that reports diff well and read
+// back simply. Returns false if the report could not be written.
+bool write_test_report(const std::string& path, const TestTimings& timings);
+
+// Reads back a report as `write_test_report` lays it out. Lines that are not a
+// timing are skipped, and a missing report reads as no timings.
+TestTimings read_test_report(const std::string& path);
+
+// Timings of the same kind as in the baseline that are slower by more than
+// `threshold`, as a fraction, in the order of `timings`.
+std::vector<TestRegression> find_regressions(const TestTimings& timings,
+                                             const TestTimings& baseline,
+                                             double threshold);
+
+// As "12.3 ms", in the unit that suits the duration.
+std::string format_seconds(double seconds);
+
+}  // namespace simon
@@ -0,0 +1,133 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "base/test_report.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "base/testing.hpp"
+
+namespace simon {
+
+TEST_CASE("TestReport") {
+  const std::string path =
+      std::filesystem::temp_directory_path() / "test_report_test.json";
+
+  SECTION("ShouldReadBackWhatWasWritten") {
+    // Preconditions.
+    TestTimings timings{
+        {"Case", {"test_case", 0.25}},
+        {"Case/Section \"quoted\"\\", {"section", 1e-7}},
+        {"Case/Section/Benchmark\t1", {"benchmark", 3.5e-3}},
+    };
+
+    // Under Test.
+    REQUIRE(write_test_report(path, timings));
+    TestTimings read = read_test_report(path);
+
+    // Postconditions.
+    REQUIRE(read.size() == timings.size());
+    for (auto&& [name, timing] : timings) {
+      REQUIRE(read.contains(name));
+      REQUIRE(read[name].kind == timing.kind);
+      REQUIRE(read[name].seconds == timing.seconds);
+    }
+  }
+
+  SECTION("ShouldSkipLineWithMalformedEscape") {
+    // Preconditions.
+    {
+      std::ofstream out{path};
+      out << "{\"name\": \"Bad\\uzz12\", \"kind\": \"section\", "
+             "\"seconds\": 1}\n"
+          << "{\"name\": \"Good\\u0041\", \"kind\": \"section\", "
+             "\"seconds\": 2}\n";
+    }
+
+    // Under Test.
+    TestTimings read = read_test_report(path);
+
+    // Postconditions.
+    REQUIRE(read.size() == 1);
+    REQUIRE(read.contains("GoodA"));
+    REQUIRE(read["GoodA"].seconds == 2);
+  }
+
+  SECTION("ShouldReadMissingReportAsEmpty") {
+    // Preconditions.
+    std::filesystem::remove(path);
+
+    // Postconditions.
+    REQUIRE(read_test_report(path).empty());
+  }
+
+  SECTION("ShouldNotWriteToMissingDirectory") {
+    // Postconditions.
+    REQUIRE_FALSE(write_test_report(
+        std::filesystem::temp_directory_path() / "missing" / "report.json",
+        {}));
+  }
+}
+
+TEST_CASE("Regressions") {
+  const TestTimings baseline{
+      {"Slower", {"test_case", 1.0}},
+      {"Within", {"test_case", 1.0}},
+      {"Faster", {"test_case", 1.0}},
+      {"Noise", {"section", MIN_COMPARED_SECONDS / 2}},
+      {"Kind", {"section", 1.0}},
+  };
+
+  SECTION("ShouldFindTimingsSlowerThanThreshold") {
+    // Preconditions.
+    const TestTimings timings{
+        {"Slower", {"test_case", 1.2}},
+        {"Within", {"test_case", 1.05}},
+        {"Faster", {"test_case", 0.5}},
+        {"New", {"test_case", 10.0}},
+    };
+
+    // Under Test.
+    auto regressions = find_regressions(timings, baseline, 0.1);
+
+    // Postconditions.
+    REQUIRE(regressions.size() == 1);
+    REQUIRE(regressions[0].name == "Slower");
+    REQUIRE(regressions[0].baseline_seconds == 1.0);
+    REQUIRE(regressions[0].change() > 0.19);
+    REQUIRE(regressions[0].change() < 0.21);
+  }
+
+  SECTION("ShouldHonorThreshold") {
+    // Preconditions.
+    const TestTimings timings{{"Within", {"test_case", 1.05}}};
+
+    // Postconditions.
+    REQUIRE(find_regressions(timings, baseline, 0.01).size() == 1);
+    REQUIRE(find_regressions(timings, baseline, 0.1).empty());
+  }
+
+  SECTION("ShouldSkipNoiseAndOtherKinds") {
+    // Preconditions.
+    const TestTimings timings{
+        {"Noise", {"section", 1.0}},
+        {"Kind", {"benchmark", 2.0}},
+    };
+
+    // Postconditions.
+    REQUIRE(find_regressions(timings, baseline, 0.1).empty());
+  }
+}
+
+TEST_CASE("FormatSeconds") {
+  SECTION("ShouldPickUnit") {
+    // Postconditions.
+    REQUIRE(format_seconds(2.5e-9) == "2.5 ns");
+    REQUIRE(format_seconds(2.5e-6) == "2.5 us");
+    REQUIRE(format_seconds(2.5e-3) == "2.5 ms");
+    REQUIRE(format_seconds(2.5) == "2.50 s");
+  }
+}
+
+}  // namespace simon
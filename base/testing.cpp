@@ -2,8 +2,16 @@
 
 #include "base/testing.hpp"
 
+#include <cstdlib>
+#include <filesystem>
+#include <format>
 #include <iomanip>
 #include <iostream>
+#include <string_view>
+
+#include "base/test_report.hpp"
+#include "catch2/benchmark/detail/catch_benchmark_stats.hpp"
+#include "catch2/catch_session.hpp"
 
 namespace simon {
 
@@ -12,8 +20,44 @@ constexpr const std::string_view section_marker{"\033[1;33m-\033[0m"};
 constexpr const std::string_view result_marker{"\033[1;33m*\033[0m"};
 constexpr const std::string_view passed{"\033[1;32mPASSED\033[0m."};
 constexpr const std::string_view failed{"\033[1;31mFAILED\033[0m."};
+constexpr const std::string_view slower{"\033[1;31mSLOWER\033[0m"};
+
+namespace {
+constexpr double DEFAULT_REGRESSION_THRESHOLD = 0.1;
+
+// Set by the listener, which has no say in the run's result, for `main` to
+// fail the run on.
+bool run_regressed = false;
 
-std::string SummaryReporter::getDescription() { return "Summary reporter"; }
+std::string join_path(const std::vector<std::string>& path) {
+  std::string joined;
+  for (auto&& name : path) {
+    joined += joined.empty() ? "" : "/";
+    joined += name;
+  }
+  return joined;
+}
+
+std::string report_path() {
+  if (const char* path = std::getenv("SIMON_TEST_REPORT")) {
+    return path;
+  }
+  if (const char* outputs = std::getenv("TEST_UNDECLARED_OUTPUTS_DIR")) {
+    return (std::filesystem::path{outputs} / "summary.json").string();
+  }
+  return {};
+}
+
+double regression_threshold() {
+  const char* threshold = std::getenv("SIMON_TEST_REGRESSION_THRESHOLD");
+  return threshold ? std::strtod(threshold, nullptr)
+                   : DEFAULT_REGRESSION_THRESHOLD;
+}
+}  // namespace
+
+std::string SummaryReporter::getDescription() {
+  return "Summary reporter, with timings";
+}
 
 void SummaryReporter::testRunStarting(Catch::TestRunInfo const& info) {
   report_.emplace_back();
@@ -25,9 +69,46 @@ void SummaryReporter::testRunEnded(Catch::TestRunStats const& info) {
   for (auto&& line : report_) {
     std::cout << line.str() << "\n";
   }
+
+  auto path = report_path();
+  if (!path.empty() && !write_test_report(path, timings_)) {
+    std::cerr << "Error: cannot write test report " << path << "\n";
+  }
+
+  const char* baseline_path = std::getenv("SIMON_TEST_BASELINE");
+  if (!baseline_path) {
+    return;
+  }
+  double threshold = regression_threshold();
+  std::cout << "\n**** Against " << baseline_path << ", threshold "
+            << std::format("{:.0f}%", threshold * 100) << ". ****\n\n";
+  auto regressions =
+      find_regressions(timings_, read_test_report(baseline_path), threshold);
+  for (auto&& regression : regressions) {
+    std::cout << result_marker << ' ' << regression.name << ' ' << slower
+              << " by " << std::format("{:.0f}%", regression.change() * 100)
+              << ": " << format_seconds(regression.seconds) << " against "
+              << format_seconds(regression.baseline_seconds) << "\n";
+  }
+  std::cout << regressions.size() << " regression(s).\n";
+  run_regressed = !regressions.empty();
+}
+
+bool SummaryReporter::regressed() { return run_regressed; }
+
+void SummaryReporter::testCaseStarting(Catch::TestCaseInfo const& info) {
+  test_case_start_ = std::chrono::steady_clock::now();
+}
+
+void SummaryReporter::testCaseEnded(Catch::TestCaseStats const& stats) {
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - test_case_start_;
+  timings_[stats.testInfo->name] = Timing{"test_case", elapsed.count()};
 }
 
 void SummaryReporter::sectionStarting(Catch::SectionInfo const& info) {
+  path_.push_back(info.name);
+
   depth_++;
   switch (depth_) {
     case 1:
@@ -45,12 +126,21 @@ void SummaryReporter::sectionStarting(Catch::SectionInfo const& info) {
 }
 
 void SummaryReporter::sectionEnded(Catch::SectionStats const& stats) {
+  // The outermost section is the test case itself, timed as a whole.
+  if (path_.size() > 1) {
+    auto& timing = timings_[join_path(path_)];
+    timing.kind = "section";
+    timing.seconds += stats.durationInSeconds;
+  }
+  path_.pop_back();
+
   depth_--;
 
   auto& result = stats.assertions.allPassed() ? passed : failed;
   switch (depth_) {
     case 1:  //
-      report_.back() << ' ' << result;
+      report_.back() << ' ' << result << ' '
+                     << format_seconds(stats.durationInSeconds);
       break;
     case 2:
       report_.emplace_back();
@@ -59,6 +149,24 @@ void SummaryReporter::sectionEnded(Catch::SectionStats const& stats) {
     default:  //
       break;
   }
+
+  // Benchmarks are listed after the line of the section that ran them.
+  for (auto&& line : benchmarks_) {
+    report_.push_back(std::move(line));
+  }
+  benchmarks_.clear();
+}
+
+void SummaryReporter::benchmarkEnded(Catch::BenchmarkStats<> const& stats) {
+  using Seconds = std::chrono::duration<double>;
+  double mean = Seconds{stats.mean.point}.count();
+  double deviation = Seconds{stats.standardDeviation.point}.count();
+  timings_[join_path(path_) + "/" + stats.info.name] = {"benchmark", mean};
+
+  benchmarks_.emplace_back();
+  benchmarks_.back() << std::string(depth_ * 2, ' ') << result_marker << ' '
+                     << stats.info.name << ": " << format_seconds(mean)
+                     << " ± " << format_seconds(deviation);
 }
 
 void SummaryReporter::assertionStarting(Catch::AssertionInfo const& info) {}
@@ -67,3 +175,13 @@ void SummaryReporter::assertionEnded(Catch::AssertionStats const& stats) {}
 CATCH_REGISTER_LISTENER(SummaryReporter)
 
 }  // namespace simon
+
+// As Catch's own main, but failing a run that passed yet regressed against its
+// baseline.
+int main(int argc, char* argv[]) {
+  const int result = Catch::Session().run(argc, argv);
+  if (result == 0 && simon::SummaryReporter::regressed()) {
+    return EXIT_FAILURE;
+  }
+  return result;
+}
@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include <chrono>
 #include <sstream>
+#include <string>
 #include <vector>
 
+#include "base/test_report.hpp"
 #include "catch2/catch_test_case_info.hpp"
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/reporters/catch_reporter_event_listener.hpp"
@@ -12,6 +15,16 @@
 
 namespace simon {
 
+// Prints a summary of every test case and section with its wall time, and of
+// every `BENCHMARK` with its mean. Timings are also written as JSON, and may be
+// compared with those of an earlier run, configured from the environment:
+//
+//   SIMON_TEST_REPORT               Where to write the JSON report. Defaults to
+//                                   summary.json in Bazel's undeclared outputs.
+//   SIMON_TEST_BASELINE             A report of an earlier run to compare with.
+//   SIMON_TEST_REGRESSION_THRESHOLD Slowdown over the baseline, as a fraction,
+//                                   past which the run fails. Defaults to 0.1.
+//
 // See: external/catch2/examples/210-Evt-EventListeners.cpp
 struct SummaryReporter : Catch::EventListenerBase {
   using EventListenerBase::EventListenerBase;
@@ -21,15 +34,31 @@ struct SummaryReporter : Catch::EventListenerBase {
   void testRunStarting(Catch::TestRunInfo const& info) override;
   void testRunEnded(Catch::TestRunStats const& stats) override;
 
+  void testCaseStarting(Catch::TestCaseInfo const& info) override;
+  void testCaseEnded(Catch::TestCaseStats const& stats) override;
+
   void sectionStarting(Catch::SectionInfo const& info) override;
   void sectionEnded(Catch::SectionStats const& stats) override;
 
+  void benchmarkEnded(Catch::BenchmarkStats<> const& stats) override;
+
   void assertionStarting(Catch::AssertionInfo const& info) override;
   void assertionEnded(Catch::AssertionStats const& stats) override;
 
+  using Timing = TestTiming;
+
+  // Whether the last run was slower than its baseline. Listeners have no say in
+  // the run's result, so the test main fails the run on it.
+  static bool regressed();
+
  private:
   std::size_t depth_ = 0;
   std::vector<std::stringstream> report_;
+  std::vector<std::stringstream> benchmarks_;  // Not yet in `report_`.
+
+  std::vector<std::string> path_;  // Names of the enclosing sections.
+  std::chrono::steady_clock::time_point test_case_start_;
+  TestTimings timings_;
 };
 
 }  // namespace simon
@@ -3,27 +3,57 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
+#include <ratio>
+
+// Ticks per simulated second; override at build time for a coarser or finer
+// clock, e.g. `--copt=-DSIMON_SIM_CLOCK_TICKS_PER_SECOND=1000`.
+#ifndef SIMON_SIM_CLOCK_TICKS_PER_SECOND
+#define SIMON_SIM_CLOCK_TICKS_PER_SECOND 1'000'000
+#endif
 
 namespace simon {
 
-class SimClock final {
+// Clock counting whole ticks of `TickPeriod` seconds. Duration arithmetic is
+// exact integer arithmetic and time points compare as plain integers, so
+// stepping the same run twice always lands on the same times. Convert with
+// `to_seconds` and `from_seconds` where time meets physical quantities.
+template <typename TickPeriod>
+class TickClock final {
  public:
-  using rep = double;
-  using period = std::ratio<1>;  // durations are fractions of one second
+  using rep = std::int64_t;
+  using period = TickPeriod;
   using duration = std::chrono::duration<rep, period>;
-  using time_point = std::chrono::time_point<SimClock>;
+  using time_point = std::chrono::time_point<TickClock>;
   static constexpr bool is_steady = true;
 
   static time_point now() {
-    static SimClock static_clock;
+    static TickClock static_clock;
     return static_clock.time_;
   }
 
  private:
-  time_point time_{duration{0.0}};
+  time_point time_{duration{0}};
 };
 
+using SimClock = TickClock<std::ratio<1, SIMON_SIM_CLOCK_TICKS_PER_SECOND>>;
+
 using Duration = SimClock::duration;
 using TimePoint = SimClock::time_point;
 
+template <typename ScalarType = double>
+constexpr ScalarType to_seconds(Duration duration) {
+  return std::chrono::duration<ScalarType>{duration}.count();
+}
+
+template <typename ScalarType = double>
+constexpr ScalarType to_seconds(TimePoint time) {
+  return to_seconds<ScalarType>(time.time_since_epoch());
+}
+
+// Rounds to the nearest tick.
+constexpr Duration from_seconds(double seconds) {
+  return std::chrono::round<Duration>(std::chrono::duration<double>{seconds});
+}
+
 }  // namespace simon
@@ -11,21 +11,46 @@ TEST_CASE("SimClock") {
     auto time_point = SimClock::now();
     REQUIRE(std::is_same_v<decltype(time_point), TimePoint>);
   }
+
+  SECTION("ShouldCountIntegerTicks") {
+    REQUIRE(std::is_integral_v<SimClock::rep>);
+  }
+
+  SECTION("ShouldHaveConfigurableTickPeriod") {
+    using MilliClock = TickClock<std::milli>;
+    REQUIRE(std::is_same_v<MilliClock::duration, std::chrono::duration<std::int64_t, std::milli>>);
+  }
 }
 
 TEST_CASE("Duration") {
-  SECTION("IsChronoDurationFractionsOfSecond") {
-    REQUIRE(std::is_same_v<Duration, std::chrono::duration<double, std::ratio<1>>>);
+  SECTION("IsChronoDurationOfWholeTicks") {
+    REQUIRE(std::is_same_v<Duration, std::chrono::duration<std::int64_t, SimClock::period>>);
+  }
+
+  SECTION("ShouldConvertToAndFromSeconds") {
+    Duration d = from_seconds(3.14);
+    CHECK(to_seconds(d) == 3.14);
   }
 
-  SECTION("ShouldConvertToAndFromDouble") {
-    Duration d{3.14};
-    CHECK(d.count() == 3.14);
+  SECTION("ShouldConvertToSecondsInAnyPrecision") {
+    Duration d = from_seconds(0.5);
+    CHECK(to_seconds<float>(d) == 0.5f);
+    CHECK(to_seconds<double>(d) == 0.5);
   }
 
   SECTION("ShouldBeZeroByDefault") {
     Duration d;
-    CHECK(d.count() == 0.0);
+    CHECK(d.count() == 0);
+  }
+
+  SECTION("ShouldAccumulateExactly") {
+    Duration step = from_seconds(0.1);
+    Duration substep = step / 10;
+    Duration sum{};
+    for (int i = 0; i < 10; ++i) {
+      sum += substep;
+    }
+    CHECK(sum == step);
   }
 }
 
@@ -34,14 +59,24 @@ TEST_CASE("TimePoint") {
     REQUIRE(std::is_same_v<TimePoint, std::chrono::time_point<SimClock>>);
   }
 
-  SECTION("ShouldConvertToAndFromDouble") {
-    TimePoint t{Duration{3.14}};
-    CHECK(t.time_since_epoch().count() == 3.14);
+  SECTION("ShouldConvertToAndFromSeconds") {
+    TimePoint t{from_seconds(3.14)};
+    CHECK(to_seconds(t) == 3.14);
   }
 
   SECTION("ShouldBeZeroByDefault") {
     TimePoint t;
-    CHECK(t.time_since_epoch().count() == 0.0);
+    CHECK(t.time_since_epoch().count() == 0);
+  }
+
+  SECTION("ShouldStepToSameTimeEveryRun") {
+    Duration substep = from_seconds(0.01);
+    TimePoint stop{from_seconds(1.0)};
+    std::size_t count = 0;
+    for (TimePoint t; t < stop; t += substep) {
+      count++;
+    }
+    CHECK(count == 100);
   }
 }
 
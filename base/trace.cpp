@@ -0,0 +1,91 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "base/trace.hpp"
+
+#include <format>
+#include <string_view>
+
+namespace simon {
+namespace {
+// Every thread's buffer, newest first. Only ever pushed to.
+std::atomic<TraceBuffer*> trace_buffers = nullptr;
+std::atomic<std::uint32_t> trace_thread_count = 0;
+
+void write_json_string(std::ostream& out, std::string_view text) {
+  out << '"';
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      out << '\\';
+    }
+    out << c;
+  }
+  out << '"';
+}
+}  // namespace
+
+TraceBuffer::TraceBuffer(std::uint32_t thread_id)
+    : events_{std::make_unique<TraceEvent[]>(CAPACITY)},
+      thread_id_{thread_id} {}
+
+TraceBuffer& TraceBuffer::local() {
+  thread_local TraceBuffer* const static_buffer = [] {
+    auto* buffer = new TraceBuffer{trace_thread_count.fetch_add(1)};
+    buffer->next_ = trace_buffers.load(std::memory_order_relaxed);
+    while (!trace_buffers.compare_exchange_weak(buffer->next_, buffer,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+    }
+    return buffer;
+  }();
+  return *static_buffer;
+}
+
+TraceWriter::TraceWriter(const std::string& path) : out_{path} {
+  out_ << "{\"traceEvents\": [";
+}
+
+void TraceWriter::drain() {
+  for (auto* buffer = trace_buffers.load(std::memory_order_acquire); buffer;
+       buffer = buffer->next_) {
+    auto tail = buffer->tail_.load(std::memory_order_relaxed);
+    auto head = buffer->head_.load(std::memory_order_acquire);
+    for (; tail != head; ++tail) {
+      const TraceEvent& event = buffer->events_[tail % TraceBuffer::CAPACITY];
+      out_ << separator_ << "  {\"name\": ";
+      write_json_string(out_, event.name);
+      out_ << ", \"cat\": ";
+      write_json_string(out_, event.category);
+      // Complete events, in microseconds.
+      out_ << std::format(
+          ", \"ph\": \"X\", \"ts\": {:.3f}, \"dur\": {:.3f}, \"pid\": 0, "
+          "\"tid\": {}",
+          event.begin * 1e-3, (event.end - event.begin) * 1e-3,
+          buffer->thread_id_);
+      out_ << '}';
+      separator_ = ",\n";
+    }
+    buffer->tail_.store(tail, std::memory_order_release);
+  }
+}
+
+bool TraceWriter::close() {
+  if (closed_) {
+    return static_cast<bool>(out_);
+  }
+  drain();
+  std::size_t dropped = 0;
+  for (auto* buffer = trace_buffers.load(std::memory_order_acquire); buffer;
+       buffer = buffer->next_) {
+    dropped += buffer->dropped();
+  }
+  out_ << "\n], \"otherData\": {\"dropped\": " << dropped << "}}\n";
+  closed_ = true;
+  return static_cast<bool>(out_.flush());
+}
+
+bool write_trace(const std::string& path) {
+  TraceWriter writer{path};
+  return writer.close();
+}
+
+}  // namespace simon
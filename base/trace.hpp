@@ -0,0 +1,147 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "base/core.hpp"
+
+// Scoped spans of where the time goes, kept per thread and written out in
+// Chrome's trace event format, for chrome://tracing or ui.perfetto.dev. Spans
+// are only recorded when built with `--config=trace`, which defines SIMON_TRACE
+// for every dependent target. Otherwise `TRACE_SPAN` compiles to nothing, and
+// its arguments are not evaluated.
+#define TRACE_CONCAT_INNER__(left__, right__) left__##right__
+#define TRACE_CONCAT__(left__, right__) TRACE_CONCAT_INNER__(left__, right__)
+
+#ifdef SIMON_TRACE
+#define TRACE_SPAN(category__, name__) \
+  ::simon::TraceSpan TRACE_CONCAT__(trace_span__, __LINE__) { category__, name__ }
+#else
+#define TRACE_SPAN(category__, name__) static_cast<void>(0)
+#endif
+
+namespace simon {
+
+#ifdef SIMON_TRACE
+constexpr bool TRACE_ENABLED = true;
+#else
+constexpr bool TRACE_ENABLED = false;
+#endif
+
+struct TraceEvent final {
+  // Both must outlive the trace, e.g. literals or `TypeRecord::name`.
+  const char* category = nullptr;
+  const char* name = nullptr;
+  std::int64_t begin = 0;  // Nanoseconds on the steady clock.
+  std::int64_t end = 0;
+};
+
+// Events of one thread, in a ring that a `TraceWriter` drains. Only that thread
+// appends, and it publishes each event by bumping the head; only the writer
+// consumes, and it frees their slots by bumping the tail. So neither takes a
+// lock. Events that find the ring full are counted and dropped until the next
+// drain. Buffers are never freed, so events outlive their thread until written,
+// and each thread that ever traced holds CAPACITY events, 2 MiB, for good.
+class TraceBuffer final {
+ public:
+  static constexpr std::size_t CAPACITY = 1 << 16;
+
+  DECLARE_COPY_DELETE(TraceBuffer);
+
+  // The calling thread's buffer, made on its first span.
+  static TraceBuffer& local();
+
+  void append(const TraceEvent& event) {
+    auto head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == CAPACITY) [[unlikely]] {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    events_[head % CAPACITY] = event;
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  // Events not yet drained.
+  std::size_t size() const {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+  // Events ever dropped.
+  std::size_t dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  friend class TraceWriter;
+
+  explicit TraceBuffer(std::uint32_t thread_id);
+
+  std::unique_ptr<TraceEvent[]> events_;
+  std::atomic<std::size_t> head_ = 0;  // Appended, ever.
+  std::atomic<std::size_t> tail_ = 0;  // Drained, ever.
+  std::atomic<std::size_t> dropped_ = 0;
+  std::uint32_t thread_id_ = 0;
+  TraceBuffer* next_ = nullptr;  // Older buffer, of another thread.
+};
+
+inline std::int64_t trace_clock() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Records the time from its construction to its destruction. Prefer
+// `TRACE_SPAN`, which leaves spans out of untraced builds.
+class TraceSpan final {
+ public:
+  DECLARE_COPY_DELETE(TraceSpan);
+
+  TraceSpan(const char* category, const char* name)
+      : category_{category}, name_{name}, begin_{trace_clock()} {}
+  ~TraceSpan() {
+    TraceBuffer::local().append(TraceEvent{.category = category_,
+                                           .name = name_,
+                                           .begin = begin_,
+                                           .end = trace_clock()});
+  }
+
+ private:
+  const char* category_;
+  const char* name_;
+  std::int64_t begin_;
+};
+
+// Writes the events of every thread as Chrome trace event JSON, draining their
+// buffers as it goes, so that a run drained often enough is traced whole.
+// Threads may go on tracing meanwhile; their later events are left for the next
+// drain. Only one writer may drain at a time.
+class TraceWriter final {
+ public:
+  DECLARE_COPY_DELETE(TraceWriter);
+
+  explicit TraceWriter(const std::string& path);
+  ~TraceWriter() { close(); }
+
+  // Writes and frees the events of every thread since the last drain.
+  void drain();
+  // Drains, then finishes the file. Returns false if any write failed.
+  bool close();
+
+ private:
+  std::ofstream out_;
+  const char* separator_ = "\n";
+  bool closed_ = false;
+};
+
+// Drains the events of every thread so far into a trace of its own. Returns
+// false if the file could not be written.
+bool write_trace(const std::string& path);
+
+}  // namespace simon
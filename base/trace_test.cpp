@@ -0,0 +1,94 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "base/trace.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "base/testing.hpp"
+
+namespace simon {
+namespace {
+std::string read_file(const std::filesystem::path& path) {
+  std::ifstream in{path};
+  std::stringstream text;
+  text << in.rdbuf();
+  return text.str();
+}
+}  // namespace
+
+TEST_CASE("Trace") {
+  SECTION("ShouldRecordSpanOnDestruction") {
+    // Preconditions.
+    auto size = TraceBuffer::local().size();
+
+    // Under Test.
+    {
+      TraceSpan span{"test", "span"};
+      REQUIRE(TraceBuffer::local().size() == size);
+    }
+
+    // Postconditions.
+    REQUIRE(TraceBuffer::local().size() == size + 1);
+  }
+
+  SECTION("ShouldRecordSpansOnlyWhenTraced") {
+    // Preconditions.
+    auto size = TraceBuffer::local().size();
+
+    // Under Test.
+    { TRACE_SPAN("test", "macro"); }
+
+    // Postconditions.
+    REQUIRE(TraceBuffer::local().size() == size + (TRACE_ENABLED ? 1 : 0));
+  }
+
+  SECTION("ShouldWriteSpansOfEveryThread") {
+    // Preconditions.
+    auto path = std::filesystem::temp_directory_path() / "trace_test.json";
+    { TraceSpan span{"test", "main"}; }
+    std::thread{[] { TraceSpan span{"test", "worker"}; }}.join();
+
+    // Under Test.
+    bool written = write_trace(path.string());
+
+    // Postconditions.
+    REQUIRE(written);
+    std::string trace = read_file(path);
+    REQUIRE(trace.starts_with("{\"traceEvents\": ["));
+    REQUIRE(trace.find("\"name\": \"main\"") != std::string::npos);
+    REQUIRE(trace.find("\"name\": \"worker\"") != std::string::npos);
+    REQUIRE(trace.find("\"ph\": \"X\"") != std::string::npos);
+    REQUIRE(TraceBuffer::local().size() == 0);
+    std::filesystem::remove(path);
+  }
+
+  SECTION("ShouldDropEventsOnlyWhileFull") {
+    // Preconditions.
+    auto path = std::filesystem::temp_directory_path() / "trace_test.json";
+    TraceWriter writer{path.string()};
+    auto dropped = TraceBuffer::local().dropped();
+    while (TraceBuffer::local().size() < TraceBuffer::CAPACITY) {
+      TraceSpan span{"test", "fill"};
+    }
+
+    // Under Test.
+    { TraceSpan span{"test", "dropped"}; }
+    writer.drain();
+    { TraceSpan span{"test", "kept"}; }
+
+    // Postconditions.
+    REQUIRE(TraceBuffer::local().dropped() == dropped + 1);
+    REQUIRE(TraceBuffer::local().size() == 1);
+    REQUIRE(writer.close());
+    std::string trace = read_file(path);
+    REQUIRE(trace.find("\"name\": \"dropped\"") == std::string::npos);
+    REQUIRE(trace.find("\"name\": \"kept\"") != std::string::npos);
+    std::filesystem::remove(path);
+  }
+}
+
+}  // namespace simon
@@ -0,0 +1,95 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+#include "base/core.hpp"
+
+namespace simon {
+
+// What diagnostics, serialization and instrumentation need to know about a
+// type, worked out once per type so that none of them demangle on a hot path.
+struct TypeRecord final {
+  // `stable_hash(to_type_name<Type>())`, the same value as the type's
+  // identity in the framework.
+  std::size_t id = 0;
+  // As `to_type_string` spells it.
+  std::string name;
+  // `stable_hash(name)`: names the type the same way under every compiler, as
+  // snapshots and event logs do.
+  std::size_t name_hash = 0;
+  std::size_t size = 0;
+  std::size_t alignment = 0;
+  bool trivially_copyable = false;
+};
+
+// Records of every type looked up with `type_record`, and of every framework
+// component and event type, by id, for tooling that only holds an id, e.g. an
+// event or component name. Records are never moved
+// nor removed, so references to them stay valid for the life of the program.
+class TypeRegistry final {
+ public:
+  DECLARE_COPY_DELETE(TypeRegistry);
+
+  static TypeRegistry& instance() {
+    static TypeRegistry static_registry;
+    return static_registry;
+  }
+
+  // Null if no type with this id has been looked up yet.
+  const TypeRecord* find(std::size_t id) const {
+    std::shared_lock lock{mutex_};
+    auto found = records_.find(id);
+    return found != records_.end() ? &found->second : nullptr;
+  }
+
+  std::size_t size() const {
+    std::shared_lock lock{mutex_};
+    return records_.size();
+  }
+
+ private:
+  template <typename Type>
+  friend const TypeRecord& type_record();
+
+  TypeRegistry() = default;
+
+  // Keeps the first record of an id: the same type instantiated in two
+  // libraries is recorded once. Two types whose names hash to the same id
+  // would be told apart by name only, so that is checked. `try_emplace` leaves
+  // `record` alone unless it inserts it.
+  const TypeRecord& insert(TypeRecord record) {
+    std::unique_lock lock{mutex_};
+    auto [found, inserted] = records_.try_emplace(record.id, std::move(record));
+    CHECK_INVARIANT(inserted || found->second.name == record.name);
+    return found->second;
+  }
+
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::size_t, TypeRecord> records_;
+};
+
+// The record of `Type`, filled in and registered on first use. Later lookups
+// cost one guarded load.
+template <typename Type>
+const TypeRecord& type_record() {
+  static_assert(std::is_object_v<Type>, "Only object types have a layout.");
+  static const TypeRecord& static_record =
+      TypeRegistry::instance().insert(TypeRecord{
+          .id = stable_hash(to_type_name<Type>()),
+          .name = to_type_string<Type>(),
+          .name_hash = stable_hash(to_type_string<Type>()),
+          .size = sizeof(Type),
+          .alignment = alignof(Type),
+          .trivially_copyable = std::is_trivially_copyable_v<Type>,
+      });
+  return static_record;
+}
+
+}  // namespace simon
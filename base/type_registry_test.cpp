@@ -0,0 +1,77 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "base/type_registry.hpp"
+
+#include <cstdint>
+#include <string>
+
+#include "base/testing.hpp"
+
+namespace simon {
+namespace {
+struct alignas(16) Aligned {
+  std::int32_t value;
+};
+
+struct Owning {
+  std::string text;
+};
+}  // namespace
+
+TEST_CASE("TypeRegistry") {
+  SECTION("ShouldRecordLayout") {
+    // Under Test.
+    const TypeRecord& record = type_record<Aligned>();
+
+    // Postconditions.
+    REQUIRE(record.size == sizeof(Aligned));
+    REQUIRE(record.alignment == 16);
+    REQUIRE(record.trivially_copyable);
+    REQUIRE_FALSE(type_record<Owning>().trivially_copyable);
+  }
+
+  SECTION("ShouldRecordDemangledName") {
+    // Postconditions.
+    REQUIRE(type_record<std::int32_t>().name == to_type_string<std::int32_t>());
+    REQUIRE(type_record<Aligned>().name == to_type_string<Aligned>());
+  }
+
+  SECTION("ShouldRecordIdHashedFromTypeName") {
+    // Postconditions.
+    REQUIRE(type_record<Aligned>().id == stable_hash(to_type_name<Aligned>()));
+    REQUIRE(type_record<Aligned>().id != type_record<Owning>().id);
+  }
+
+  SECTION("ShouldRecordNameHashedFromName") {
+    // Postconditions.
+    REQUIRE(type_record<Aligned>().name_hash ==
+            stable_hash(to_type_string<Aligned>()));
+  }
+
+  SECTION("ShouldRecordEachTypeOnce") {
+    // Preconditions.
+    const TypeRecord& record = type_record<Aligned>();
+    std::size_t size = TypeRegistry::instance().size();
+
+    // Under Test.
+    const TypeRecord& again = type_record<Aligned>();
+
+    // Postconditions.
+    REQUIRE(&again == &record);
+    REQUIRE(TypeRegistry::instance().size() == size);
+  }
+
+  SECTION("ShouldFindRecordById") {
+    // Preconditions.
+    const TypeRecord& record = type_record<Owning>();
+
+    // Under Test.
+    const TypeRecord* found = TypeRegistry::instance().find(record.id);
+
+    // Postconditions.
+    REQUIRE(found == &record);
+    REQUIRE(TypeRegistry::instance().find(stable_hash("unrecorded")) == nullptr);
+  }
+}
+
+}  // namespace simon
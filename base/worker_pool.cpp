@@ -0,0 +1,125 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "base/worker_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace simon {
+
+WorkerPool::WorkerPool(std::size_t thread_count) {
+  if (thread_count == 0) {
+    thread_count = std::max(1u, std::thread::hardware_concurrency());
+  }
+  shares_ = std::make_unique<Share[]>(thread_count);
+  threads_.reserve(thread_count);
+  for (std::size_t worker = 0; worker < thread_count; ++worker) {
+    threads_.emplace_back([this, worker] { work(worker); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard lock{mutex_};
+    stopping_ = true;
+  }
+  batch_started_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::for_each_index(std::size_t count,
+                                const std::function<void(std::size_t)>& task) {
+  std::unique_lock lock{mutex_};
+  const std::size_t workers = threads_.size();
+  for (std::size_t worker = 0; worker < workers; ++worker) {
+    std::lock_guard share_lock{shares_[worker].mutex};
+    shares_[worker].begin = count * worker / workers;
+    shares_[worker].end = count * (worker + 1) / workers;
+  }
+  task_ = &task;
+  working_ = workers;
+  error_ = nullptr;
+  batch_++;
+  batch_started_.notify_all();
+
+  batch_done_.wait(lock, [this] { return working_ == 0; });
+  task_ = nullptr;
+  if (error_) {
+    std::rethrow_exception(std::exchange(error_, nullptr));
+  }
+}
+
+void WorkerPool::work(std::size_t worker) {
+  std::size_t batch = 0;
+  while (true) {
+    const std::function<void(std::size_t)>* task = nullptr;
+    {
+      std::unique_lock lock{mutex_};
+      batch_started_.wait(lock, [&] { return stopping_ || batch_ != batch; });
+      if (stopping_) {
+        return;
+      }
+      batch = batch_;
+      task = task_;
+    }
+
+    std::exception_ptr error;
+    for (std::size_t index = 0; next_index(worker, &index);) {
+      try {
+        (*task)(index);
+      } catch (...) {
+        error = error ? error : std::current_exception();
+      }
+    }
+
+    std::lock_guard lock{mutex_};
+    error_ = error_ ? error_ : error;
+    if (--working_ == 0) {
+      batch_done_.notify_one();
+    }
+  }
+}
+
+bool WorkerPool::next_index(std::size_t worker, std::size_t* index) {
+  {
+    Share& share = shares_[worker];
+    std::lock_guard lock{share.mutex};
+    if (share.begin < share.end) {
+      *index = share.begin++;
+      return true;
+    }
+  }
+  return steal_index(worker, index);
+}
+
+// Locks one share at a time, so that thieves never wait on each other in a
+// cycle.
+bool WorkerPool::steal_index(std::size_t thief, std::size_t* index) {
+  const std::size_t workers = threads_.size();
+  for (std::size_t offset = 1; offset < workers; ++offset) {
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    {
+      Share& victim = shares_[(thief + offset) % workers];
+      std::lock_guard lock{victim.mutex};
+      if (victim.begin == victim.end) {
+        continue;
+      }
+      end = victim.end;
+      begin = victim.end - (victim.end - victim.begin + 1) / 2;
+      victim.end = begin;
+    }
+
+    *index = begin;
+    Share& share = shares_[thief];
+    std::lock_guard lock{share.mutex};
+    share.begin = begin + 1;
+    share.end = end;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace simon
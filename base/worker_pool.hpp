@@ -0,0 +1,66 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "base/core.hpp"
+
+namespace simon {
+
+// Threads that run a batch of independent tasks, one per index, and wait for
+// the next batch. Each worker starts on its own contiguous share of a batch's
+// indices; one that runs out steals the later half of what another has left,
+// so uneven tasks still keep every worker busy till the batch is done.
+class WorkerPool final {
+ public:
+  DECLARE_COPY_DELETE(WorkerPool);
+
+  // Defaults to a worker per hardware thread.
+  explicit WorkerPool(std::size_t thread_count = 0);
+  ~WorkerPool();
+
+  std::size_t thread_count() const { return threads_.size(); }
+
+  // Calls `task(index)` for every index in [0, count) and returns once all
+  // have returned. Rethrows the first exception a task threw, after the rest
+  // of the batch has run. Batches run one at a time.
+  void for_each_index(std::size_t count,
+                      const std::function<void(std::size_t)>& task);
+
+ private:
+  static constexpr std::size_t CACHE_LINE = 64;
+
+  // What is left of one worker's share of a batch.
+  struct alignas(CACHE_LINE) Share final {
+    std::mutex mutex;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+  };
+
+  void work(std::size_t worker);
+  bool next_index(std::size_t worker, std::size_t* index);
+  bool steal_index(std::size_t thief, std::size_t* index);
+
+  std::unique_ptr<Share[]> shares_;
+
+  std::mutex mutex_;
+  std::condition_variable batch_started_;
+  std::condition_variable batch_done_;
+  const std::function<void(std::size_t)>* task_ = nullptr;
+  std::size_t batch_ = 0;    // Counts batches started, for waking workers.
+  std::size_t working_ = 0;  // Workers yet to finish the current batch.
+  std::exception_ptr error_;
+  bool stopping_ = false;
+
+  std::vector<std::thread> threads_;  // Last, to start once the rest is made.
+};
+
+}  // namespace simon
@@ -0,0 +1,92 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "base/worker_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "base/testing.hpp"
+
+namespace simon {
+
+TEST_CASE("WorkerPool") {
+  WorkerPool pool{4};
+
+  SECTION("ShouldRunEveryIndexOnce") {
+    // Preconditions.
+    std::vector<std::atomic<int>> runs(1000);
+
+    // Under Test.
+    pool.for_each_index(runs.size(),
+                        [&runs](std::size_t index) { runs[index]++; });
+
+    // Postconditions.
+    for (auto& run : runs) {
+      REQUIRE(run == 1);
+    }
+  }
+
+  SECTION("ShouldRunBatchesOneAfterAnother") {
+    // Preconditions.
+    std::atomic<std::size_t> sum = 0;
+
+    // Under Test.
+    for (std::size_t batch = 0; batch < 100; ++batch) {
+      pool.for_each_index(batch,
+                          [&sum](std::size_t index) { sum += index + 1; });
+    }
+
+    // Postconditions.
+    std::size_t expected = 0;
+    for (std::size_t batch = 0; batch < 100; ++batch) {
+      expected += batch * (batch + 1) / 2;
+    }
+    REQUIRE(sum == expected);
+  }
+
+  SECTION("ShouldStealFromSlowWorkers") {
+    // Preconditions.
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+
+    // Under Test.
+    // The first worker's share is slow; the others must take it over.
+    pool.for_each_index(64, [&](std::size_t index) {
+      if (index < 16) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+      }
+      std::lock_guard lock{mutex};
+      if (index < 16) {
+        threads.insert(std::this_thread::get_id());
+      }
+    });
+
+    // Postconditions.
+    REQUIRE(threads.size() > 1);
+  }
+
+  SECTION("ShouldRethrowAfterRunningBatch") {
+    // Preconditions.
+    std::atomic<int> runs = 0;
+
+    // Under Test.
+    auto run_batch = [&] {
+      pool.for_each_index(100, [&runs](std::size_t index) {
+        runs++;
+        if (index == 50) {
+          throw std::runtime_error{"task"};
+        }
+      });
+    };
+
+    // Postconditions.
+    REQUIRE_THROWS_AS(run_batch(), std::runtime_error);
+    REQUIRE(runs == 100);
+  }
+}
+
+}  // namespace simon
@@ -2,13 +2,17 @@
 
 #pragma once
 
+#include <tuple>
+
 #include "base/math.hpp"
 #include "framework/component.hpp"
 
 namespace simon::component {
 
 struct Controls final : public framework::Component<Controls> {
-  Vec3 acceleration;
+  PaddedVec3 acceleration;
+
+  static constexpr std::tuple SNAPSHOT_FIELDS{&Controls::acceleration};
 };
 
 }  // namespace simon::component
@@ -2,13 +2,17 @@
 
 #pragma once
 
+#include <tuple>
+
 #include "base/math.hpp"
 #include "framework/component.hpp"
 
 namespace simon::component {
 
 struct Environment final : public framework::Component<Environment> {
-  Vec3 wind;
+  PaddedVec3 wind;
+
+  static constexpr std::tuple SNAPSHOT_FIELDS{&Environment::wind};
 };
 
 }  // namespace simon::component
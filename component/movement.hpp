@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <tuple>
+
 #include "base/math.hpp"
 #include "framework/component.hpp"
 
@@ -12,12 +14,14 @@ struct Physical;
 struct Controls;
 
 struct Movement final : public framework::Component<Movement> {
-  Vec3 position;
-  Vec3 velocity;
+  PaddedVec3 position;
+  PaddedVec3 velocity;
 
   Environment* environment = nullptr;
   Physical* physical = nullptr;
   Controls* controls = nullptr;
+
+  static constexpr std::tuple SNAPSHOT_FIELDS{&Movement::position, &Movement::velocity};
 };
 
 }  // namespace simon::component
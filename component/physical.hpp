@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <tuple>
+
 #include "base/math.hpp"
 #include "framework/component.hpp"
 
@@ -10,9 +12,12 @@ namespace simon::component {
 struct Movement;
 
 struct Physical final : public framework::Component<Physical> {
-  double radius;
-  double wind_resistance_factor = 1.0;
+  Scalar radius;
+  Scalar wind_resistance_factor = 1.0;
   Movement* movement = nullptr;
+
+  static constexpr std::tuple SNAPSHOT_FIELDS{&Physical::radius,
+                                              &Physical::wind_resistance_factor};
 };
 
 }  // namespace simon::component
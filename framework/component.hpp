@@ -7,7 +7,7 @@
 namespace simon::framework {
 
 struct ComponentName final : public Name {
-  ComponentName(Name name) : Name{name} {}
+  constexpr ComponentName(Name name) : Name{name} {}
 };
 
 class ComponentBase {
@@ -19,7 +19,7 @@ template <typename ComponentType>
 class Component : public ComponentBase, public PerTypeIdentity<ComponentType> {
  public:
   ComponentName component_name() const override { return Component::name(); }
-  static ComponentName name() { return Component::id().name(); }
+  static constexpr ComponentName name() { return Component::id().name(); }
 };
 
 }  // namespace simon::framework
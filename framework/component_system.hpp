@@ -2,13 +2,24 @@
 
 #pragma once
 
+#include <array>
+#include <format>
 #include <iostream>
 #include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "base/core.hpp"
+#include "base/memory.hpp"
 #include "base/time.hpp"
+#include "base/trace.hpp"
+#include "base/type_registry.hpp"
 #include "framework/component.hpp"
 #include "framework/entity.hpp"
+#include "framework/snapshot.hpp"
 
 namespace simon::framework {
 
@@ -23,14 +34,148 @@ class TypedComponentSystemBase : public ComponentSystemBase {
   ComponentName component_name() const override { return ComponentType::name(); }
 
   ComponentType* attach(Entity* entity) {
-    components_.emplace_back(std::make_unique<ComponentType>());
-    auto* component = components_.back().get();
-    entity->attach(component);
+    auto* component = &components_.emplace_back();
+    entity->attach(ComponentType::name(), component);
     return component;
   }
 
+  // Attaches the `index`-th component, e.g. one made by `restore_detached()`.
+  ComponentType* attach(Entity* entity, std::size_t index) {
+    auto* component = &components_[index];
+    entity->attach(ComponentType::name(), component);
+    return component;
+  }
+
+  std::size_t size() const { return components_.size(); }
+  // Entities attached to these components must be discarded along with them. The storage is kept
+  // for the next components attached, e.g. on restore.
+  void clear() { components_.clear(); }
+
+  // What the components take, slack in the storage's blocks included.
+  MemoryUsage memory_usage() const {
+    return {.reserved = memory_.reserved(),
+            .in_use = components_.size() * sizeof(ComponentType),
+            .allocations = memory_.allocations()};
+  }
+  void begin_memory_step() { memory_.begin_step(); }
+
+  template <typename VisitorType>
+  void for_each(VisitorType&& visit) const {
+    for (auto&& component : components_) {
+      visit(component);
+    }
+  }
+
+  // Components opt into snapshots by listing the members that hold their
+  // state, e.g. `static constexpr std::tuple SNAPSHOT_FIELDS{&T::a, &T::b}`.
+  // Each field is saved as one column in attach order; members that wire
+  // components together are left for the owner to reconnect on restore.
+  void save(SnapshotWriter* writer) const {
+    if constexpr (requires { ComponentType::SNAPSHOT_FIELDS; }) {
+      std::size_t index = 0;
+      std::apply([&](auto... fields) { (save_field(writer, fields, index++), ...); },
+                 ComponentType::SNAPSHOT_FIELDS);
+    }
+  }
+
+  // Restores into the components already attached, which must be as many as
+  // were saved.
+  bool restore(const SnapshotReader& reader) {
+    bool restored = true;
+    if constexpr (requires { ComponentType::SNAPSHOT_FIELDS; }) {
+      std::size_t index = 0;
+      std::apply(
+        [&](auto... fields) { ((restored &= restore_field(reader, fields, index++)), ...); },
+        ComponentType::SNAPSHOT_FIELDS);
+    }
+    return restored;
+  }
+
+  // Appends `count` components made from their saved fields, in one pass that writes each
+  // component once, whole, rather than once per field. They are attached to nothing: their owner
+  // attaches them with `attach(entity, index)`. Appends none if a field was saved for a different
+  // count.
+  bool restore_detached(const SnapshotReader& reader, std::size_t count) {
+    components_.reserve(components_.size() + count);
+    if constexpr (requires { ComponentType::SNAPSHOT_FIELDS; }) {
+      constexpr auto& FIELDS = ComponentType::SNAPSHOT_FIELDS;
+      constexpr std::size_t FIELD_COUNT = std::tuple_size_v<std::remove_cvref_t<decltype(FIELDS)>>;
+      return [&]<std::size_t... INDEX>(std::index_sequence<INDEX...>) {
+        std::tuple columns{read_column(reader, std::get<INDEX>(FIELDS), INDEX)...};
+        if (((std::get<INDEX>(columns).size() != count) || ...)) {
+          return false;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+          auto& component = components_.emplace_back();
+          ((component.*std::get<INDEX>(FIELDS) = std::get<INDEX>(columns)[i]), ...);
+        }
+        return true;
+      }(std::make_index_sequence<FIELD_COUNT>{});
+    } else {
+      for (std::size_t i = 0; i < count; ++i) {
+        components_.emplace_back();
+      }
+      return true;
+    }
+  }
+
  protected:
-  std::vector<std::unique_ptr<ComponentType>> components_;
+  MemoryAccount memory_;
+  // Stable addresses without a heap node each, in blocks that restore fills in bulk.
+  BlockVector<ComponentType, CountingAllocator<ComponentType>> components_{
+    CountingAllocator<ComponentType>{&memory_}};
+
+ private:
+  // Worked out once per type rather than on every save.
+  static SnapshotTag field_tag(std::size_t index) {
+    constexpr std::size_t FIELD_COUNT =
+      std::tuple_size_v<std::remove_cvref_t<decltype(ComponentType::SNAPSHOT_FIELDS)>>;
+    static const std::array<SnapshotTag, FIELD_COUNT> static_tags = [] {
+      std::array<SnapshotTag, FIELD_COUNT> tags;
+      for (std::size_t i = 0; i < FIELD_COUNT; ++i) {
+        tags[i] =
+          snapshot_tag(std::format("component/{}/{}", type_record<ComponentType>().name, i));
+      }
+      return tags;
+    }();
+    return static_tags[index];
+  }
+
+  template <typename FieldType>
+  void save_field(SnapshotWriter* writer,
+                  FieldType ComponentType::*field,
+                  std::size_t index) const {
+    std::vector<FieldType> column;
+    column.reserve(components_.size());
+    for (auto&& component : components_) {
+      column.push_back(component.*field);
+    }
+    writer->write(field_tag(index), std::span<const FieldType>{column});
+  }
+
+  template <typename FieldType>
+  static std::span<const FieldType> read_column(const SnapshotReader& reader,
+                                                FieldType ComponentType::*,
+                                                std::size_t index) {
+    return reader.section<FieldType>(field_tag(index));
+  }
+
+  template <typename FieldType>
+  bool restore_field(const SnapshotReader& reader,
+                     FieldType ComponentType::*field,
+                     std::size_t index) {
+    auto column = reader.section<FieldType>(field_tag(index));
+    if (column.size() != components_.size()) {
+      return false;
+    }
+    auto value = column.begin();
+    components_.for_each_block([&](std::span<ComponentType> block) {
+      for (auto&& component : block) {
+        component.*field = *value++;
+      }
+    });
+    return true;
+  }
 };
 
 template <typename ComponentType, typename ComputationType>
@@ -43,16 +188,25 @@ struct ComponentSystem final : public TypedComponentSystemBase<ComponentType> {
 
   template <typename EventSink>
   void operator()(TimePoint time, Duration step, EventSink events) {
-    for (auto&& component : this->components_) {
-      compute_.prepare(component.get());
+    {
+      TRACE_SPAN("prepare", type_record<ComponentType>().name.c_str());
+      for (auto&& component : this->components_) {
+        compute_.prepare(&component);
+      }
     }
 
-    for (auto&& component : this->components_) {
-      compute_(component.get(), time, step, events);
+    {
+      TRACE_SPAN("compute", type_record<ComponentType>().name.c_str());
+      for (auto&& component : this->components_) {
+        compute_(&component, time, step, events);
+      }
     }
 
-    for (auto&& component : this->components_) {
-      compute_.resolve(component.get());
+    {
+      TRACE_SPAN("resolve", type_record<ComponentType>().name.c_str());
+      for (auto&& component : this->components_) {
+        compute_.resolve(&component);
+      }
     }
   }
 
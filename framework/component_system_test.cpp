@@ -2,6 +2,8 @@
 
 #include "framework/component_system.hpp"
 
+#include <cstdio>
+#include <filesystem>
 #include <type_traits>
 #include <vector>
 
@@ -9,6 +11,15 @@
 #include "base/time.hpp"
 
 namespace simon::framework {
+namespace {
+struct Saved final : public Component<Saved> {
+  int a = 0;
+  double b = 0.0;
+  Saved* wiring = nullptr;
+
+  static constexpr std::tuple SNAPSHOT_FIELDS{&Saved::a, &Saved::b};
+};
+}  // namespace
 
 TEST_CASE("ComponentSystem") {
   struct T final : public Component<T> {};
@@ -41,6 +52,23 @@ TEST_CASE("ComponentSystem") {
     }
   }
 
+  SECTION("ShouldVisitEachAttachedComponent") {
+    // Setup
+    Entity a, b;
+    auto* component_a = sys.attach(&a);
+    auto* component_b = sys.attach(&b);
+
+    // Act
+    std::vector<const T*> visited;
+    sys.for_each([&visited](const T& component) { visited.push_back(&component); });
+
+    // Verify
+    REQUIRE(sys.size() == 2);
+    REQUIRE(visited.size() == 2);
+    CHECK(visited[0] == component_a);
+    CHECK(visited[1] == component_b);
+  }
+
   SECTION("ShouldInvokeComputation") {
     // Setup
     Entity a;
@@ -57,4 +85,84 @@ TEST_CASE("ComponentSystem") {
   }
 }
 
+TEST_CASE("ComponentSystemSnapshot") {
+  const std::string path = std::filesystem::temp_directory_path() / "component_system_test.snap";
+  ComponentSystem<Saved, ComputeNone> sys;
+  Entity a, b;
+  sys.attach(&a)->a = 1;
+  sys.attach(&b)->b = 2.0;
+
+  SECTION("ShouldRestoreSavedFields") {
+    // Setup
+    SnapshotWriter writer{path};
+    sys.save(&writer);
+    REQUIRE(writer.finish());
+
+    // Act
+    ComponentSystem<Saved, ComputeNone> restored;
+    Entity c, d;
+    restored.attach(&c);
+    restored.attach(&d);
+    SnapshotReader reader{path};
+    REQUIRE(restored.restore(reader));
+
+    // Verify
+    CHECK(c.component<Saved>()->a == 1);
+    CHECK(d.component<Saved>()->b == 2.0);
+  }
+
+  SECTION("ShouldRestoreDetachedComponentsForOwnerToAttach") {
+    // Setup
+    SnapshotWriter writer{path};
+    sys.save(&writer);
+    REQUIRE(writer.finish());
+
+    // Act
+    ComponentSystem<Saved, ComputeNone> restored;
+    SnapshotReader reader{path};
+    REQUIRE(restored.restore_detached(reader, 2));
+    Entity c, d;
+    restored.attach(&c, 0);
+    restored.attach(&d, 1);
+
+    // Verify
+    REQUIRE(restored.size() == 2);
+    CHECK(c.component<Saved>()->a == 1);
+    CHECK(d.component<Saved>()->b == 2.0);
+  }
+
+  SECTION("ShouldNotRestoreDetachedForDifferentCount") {
+    // Setup
+    SnapshotWriter writer{path};
+    sys.save(&writer);
+    REQUIRE(writer.finish());
+
+    // Act
+    ComponentSystem<Saved, ComputeNone> restored;
+    SnapshotReader reader{path};
+
+    // Verify
+    CHECK(!restored.restore_detached(reader, 3));
+    CHECK(restored.size() == 0);
+  }
+
+  SECTION("ShouldNotRestoreIntoDifferentCount") {
+    // Setup
+    SnapshotWriter writer{path};
+    sys.save(&writer);
+    REQUIRE(writer.finish());
+
+    // Act
+    ComponentSystem<Saved, ComputeNone> restored;
+    Entity c;
+    restored.attach(&c);
+    SnapshotReader reader{path};
+
+    // Verify
+    CHECK(!restored.restore(reader));
+  }
+
+  std::remove(path.c_str());
+}
+
 }  // namespace simon::framework
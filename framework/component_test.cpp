@@ -5,6 +5,7 @@
 #include <type_traits>
 
 #include "base/testing.hpp"
+#include "base/type_registry.hpp"
 
 namespace simon::framework {
 
@@ -23,6 +24,17 @@ TEST_CASE("Component") {
   SECTION("ShouldHaveSameNameForBaseObjectAsType") {
     CHECK(static_cast<ComponentBase*>(&c)->component_name() == T::name());
   }
+
+  SECTION("ShouldHaveConstantNameHashedFromTypeName") {
+    constexpr ComponentName name = T::name();
+    CHECK(name.value() == stable_hash(to_type_name<T>()));
+  }
+
+  SECTION("ShouldBeRecordedByName") {
+    const TypeRecord* record = TypeRegistry::instance().find(T::name().value());
+    REQUIRE(record != nullptr);
+    CHECK(record->name == to_type_string<T>());
+  }
 }
 
 }  // namespace simon::framework
@@ -2,7 +2,11 @@
 
 #pragma once
 
-#include <map>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
 
 #include "framework/component.hpp"
 #include "framework/identity.hpp"
@@ -15,17 +19,55 @@ struct EntityName final : public Name {
 
 class Entity : public PerObjectIdentity {
  public:
+  Entity() = default;
+  explicit Entity(Identity id) : PerObjectIdentity{std::move(id)} {}
+
   EntityName entity_name() const { return id_.name(); }
-  void attach(ComponentBase* component) { components_[component->component_name()] = component; }
+
+  // Replaces any component of the same name.
+  void attach(ComponentBase* component) { attach(component->component_name(), component); }
+
+  // As above, for callers that know the name already, which spares reading the component.
+  void attach(ComponentName component_name, ComponentBase* component) {
+    const std::size_t name = component_name.value();
+    if (Slot* slot = find(name)) {
+      slot->component = component;
+    } else if (inline_count_ < INLINE_COMPONENTS) {
+      inline_[inline_count_++] = {name, component};
+    } else {
+      overflow_.push_back({name, component});
+    }
+  }
 
   template <typename ComponentType>
   ComponentType* component() {
-    auto iter = components_.find(ComponentType::name());
-    return iter != components_.end() ? dynamic_cast<ComponentType*>(iter->second) : nullptr;
+    Slot* slot = find(ComponentType::name().value());
+    return slot ? dynamic_cast<ComponentType*>(slot->component) : nullptr;
   }
 
  private:
-  std::map<ComponentName, ComponentBase*> components_;
+  // Enough for most entities, so that making, finding and dropping their components allocates
+  // nothing; the rest spill onto the heap.
+  static constexpr std::size_t INLINE_COMPONENTS = 4;
+
+  struct Slot final {
+    std::size_t name = 0;  // `ComponentName::value()`.
+    ComponentBase* component = nullptr;
+  };
+
+  Slot* find(std::size_t name) {
+    auto has_name = [name](const Slot& slot) { return slot.name == name; };
+    auto* inline_end = inline_.begin() + inline_count_;
+    if (auto* slot = std::find_if(inline_.begin(), inline_end, has_name); slot != inline_end) {
+      return slot;
+    }
+    auto slot = std::find_if(overflow_.begin(), overflow_.end(), has_name);
+    return slot != overflow_.end() ? &*slot : nullptr;
+  }
+
+  std::array<Slot, INLINE_COMPONENTS> inline_;
+  std::size_t inline_count_ = 0;
+  std::vector<Slot> overflow_;
 };
 
 }  // namespace simon::framework
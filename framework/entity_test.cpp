@@ -21,10 +21,37 @@ TEST_CASE("Component") {
     CHECK(a.entity_name() != b.entity_name());
   }
 
+  SECTION("ShouldHaveSameNameWhenReissued") {
+    Entity copy{Identity{a.entity_name().value()}};
+    CHECK(copy.entity_name() == a.entity_name());
+  }
+
   SECTION("ShouldAttachAndFindComponents") {
     a.attach(&c);
     CHECK(a.component<T>() == &c);
   }
+
+  SECTION("ShouldReplaceComponentOfSameName") {
+    T other;
+    a.attach(&c);
+    a.attach(&other);
+    CHECK(a.component<T>() == &other);
+  }
+
+  SECTION("ShouldFindComponentsBeyondInlineSlots") {
+    struct U1 final : public Component<U1> {} u1;
+    struct U2 final : public Component<U2> {} u2;
+    struct U3 final : public Component<U3> {} u3;
+    struct U4 final : public Component<U4> {} u4;
+    a.attach(&c);
+    a.attach(&u1);
+    a.attach(&u2);
+    a.attach(&u3);
+    a.attach(&u4);
+    CHECK(a.component<T>() == &c);
+    CHECK(a.component<U4>() == &u4);
+    CHECK(b.component<U4>() == nullptr);
+  }
 }
 
 }  // namespace simon::framework
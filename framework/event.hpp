@@ -10,7 +10,7 @@
 namespace simon::framework {
 
 struct EventName final : public Name {
-  EventName(Name name) : Name{name} {}
+  constexpr EventName(Name name) : Name{name} {}
 };
 
 class EventBase {
@@ -30,7 +30,7 @@ class Event final : public EventBase, public PerTypeIdentity<MessageType> {
   const MessageType& data() const { return message_; }
 
   EventName event_name() const override { return Event::name(); }
-  static EventName name() { return Event::id().name(); }
+  static constexpr EventName name() { return Event::id().name(); }
 
  private:
   TimePoint time_{};
@@ -0,0 +1,78 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "framework/event_log.hpp"
+
+#include <cstring>
+
+namespace simon::framework {
+namespace {
+constexpr char EVENT_LOG_MAGIC[8] = {'S', 'I', 'M', 'O', 'N', 'L', 'O', 'G'};
+
+// Bounds a record's payload so that a corrupt size is not taken at its word.
+constexpr std::uint64_t MAX_PAYLOAD_SIZE = 1 << 20;
+}  // namespace
+
+EventLogWriter::EventLogWriter(const std::string& path) : file_{std::fopen(path.c_str(), "wb")} {
+  EventLogHeader header{};
+  std::memcpy(header.magic, EVENT_LOG_MAGIC, sizeof(EVENT_LOG_MAGIC));
+  header.version = EVENT_LOG_VERSION;
+  failed_ = !file_ || std::fwrite(&header, sizeof(header), 1, file_) != 1;
+}
+
+EventLogWriter::~EventLogWriter() {
+  if (file_) {
+    std::fclose(file_);
+  }
+}
+
+void EventLogWriter::append_bytes(SnapshotTag tag,
+                                  TimePoint time,
+                                  const void* data,
+                                  std::size_t size) {
+  if (failed_) {
+    return;
+  }
+
+  EventLogRecord record{.tag = tag, .time = time.time_since_epoch().count(), .size = size};
+  failed_ |= std::fwrite(&record, sizeof(record), 1, file_) != 1;
+  failed_ |= std::fwrite(data, 1, size, file_) != size;
+}
+
+bool EventLogWriter::flush() {
+  if (file_) {
+    failed_ |= std::fflush(file_) != 0;
+  }
+  return !failed_;
+}
+
+EventLogReader::EventLogReader(const std::string& path) : file_{std::fopen(path.c_str(), "rb")} {
+  EventLogHeader header{};
+  bool valid = file_ && std::fread(&header, sizeof(header), 1, file_) == 1 &&
+               std::memcmp(header.magic, EVENT_LOG_MAGIC, sizeof(EVENT_LOG_MAGIC)) == 0 &&
+               header.version == EVENT_LOG_VERSION;
+  if (!valid && file_) {
+    std::fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+EventLogReader::~EventLogReader() {
+  if (file_) {
+    std::fclose(file_);
+  }
+}
+
+bool EventLogReader::next(EventLogEntry* entry) {
+  EventLogRecord record{};
+  if (!file_ || std::fread(&record, sizeof(record), 1, file_) != 1 ||
+      record.size > MAX_PAYLOAD_SIZE) {
+    return false;
+  }
+
+  entry->tag = record.tag;
+  entry->time = TimePoint{Duration{record.time}};
+  entry->payload.resize(record.size);
+  return std::fread(entry->payload.data(), 1, record.size, file_) == record.size;
+}
+
+}  // namespace simon::framework
@@ -0,0 +1,98 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "base/core.hpp"
+#include "base/time.hpp"
+#include "base/type_registry.hpp"
+#include "framework/snapshot.hpp"
+
+namespace simon::framework {
+
+// Event logs are a header followed by one record per event, in the order the
+// events were published. Records are only ever appended, so a log cut short by
+// a crash is still readable up to its last complete record.
+//
+//   EventLogHeader | EventLogRecord payload | EventLogRecord payload | ...
+//
+constexpr std::uint32_t EVENT_LOG_VERSION = 1;
+
+struct EventLogHeader final {
+  char magic[8];
+  std::uint32_t version = 0;
+  std::uint32_t reserved = 0;
+};
+
+struct EventLogRecord final {
+  std::uint64_t tag = 0;
+  std::int64_t time = 0;
+  std::uint64_t size = 0;
+};
+
+// Tags name a message type the same way in every run, by its demangled name as
+// component snapshot tags do. Unlike event names, which hash the compiler's own
+// spelling, logs written by one compiler's build replay in another's. The tag is
+// worked out with the type's record, so this costs the record's one lookup.
+template <typename MessageType>
+SnapshotTag event_log_tag() {
+  return type_record<MessageType>().name_hash;
+}
+
+struct EventLogEntry final {
+  SnapshotTag tag = 0;
+  TimePoint time;
+  std::vector<std::byte> payload;
+};
+
+class EventLogWriter final {
+ public:
+  explicit EventLogWriter(const std::string& path);
+  ~EventLogWriter();
+
+  EventLogWriter(const EventLogWriter&) = delete;
+  EventLogWriter& operator=(const EventLogWriter&) = delete;
+
+  bool is_open() const { return file_ != nullptr; }
+
+  template <SnapshotValue MessageType>
+  void append(TimePoint time, const MessageType& message) {
+    append_bytes(event_log_tag<MessageType>(), time, &message, sizeof(message));
+  }
+
+  // Pushes buffered records to the file. Returns false if any write failed.
+  bool flush();
+
+ private:
+  void append_bytes(SnapshotTag tag, TimePoint time, const void* data, std::size_t size);
+
+  std::FILE* file_ = nullptr;
+  bool failed_ = false;
+};
+
+class EventLogReader final {
+ public:
+  explicit EventLogReader(const std::string& path);
+  ~EventLogReader();
+
+  EventLogReader(const EventLogReader&) = delete;
+  EventLogReader& operator=(const EventLogReader&) = delete;
+
+  // True if the file is an event log of this version.
+  bool is_open() const { return file_ != nullptr; }
+
+  // Reads the next record. Returns false at the end of the log, including
+  // when the last record was only partly written.
+  bool next(EventLogEntry* entry);
+
+ private:
+  std::FILE* file_ = nullptr;
+};
+
+}  // namespace simon::framework
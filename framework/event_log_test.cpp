@@ -0,0 +1,79 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "framework/event_log.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#include "base/testing.hpp"
+
+namespace simon::framework {
+
+TEST_CASE("EventLog") {
+  const std::string path = std::filesystem::temp_directory_path() / "event_log_test.log";
+  TimePoint start{from_seconds(0.0)};
+  TimePoint later{from_seconds(1.0)};
+
+  struct M {
+    int value = 0;
+  };
+  struct N {
+    double value = 0.0;
+  };
+
+  SECTION("ShouldReadBackRecordsInOrder") {
+    {
+      EventLogWriter log{path};
+      REQUIRE(log.is_open());
+      log.append(later, M{5});
+      log.append(start, N{2.0});
+      REQUIRE(log.flush());
+    }
+
+    EventLogReader reader{path};
+    REQUIRE(reader.is_open());
+
+    EventLogEntry entry;
+    REQUIRE(reader.next(&entry));
+    CHECK(entry.tag == event_log_tag<M>());
+    CHECK(entry.time == later);
+    M m;
+    REQUIRE(entry.payload.size() == sizeof(m));
+    std::memcpy(&m, entry.payload.data(), sizeof(m));
+    CHECK(m.value == 5);
+
+    REQUIRE(reader.next(&entry));
+    CHECK(entry.tag == event_log_tag<N>());
+    CHECK(entry.time == start);
+    CHECK(!reader.next(&entry));
+  }
+
+  SECTION("ShouldTagByDemangledName") {
+    CHECK(event_log_tag<M>() == snapshot_tag(to_type_string<M>()));
+    CHECK(event_log_tag<M>() != event_log_tag<N>());
+  }
+
+  SECTION("ShouldStopAtPartlyWrittenRecord") {
+    {
+      EventLogWriter log{path};
+      log.append(start, M{1});
+      log.append(later, M{2});
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+    EventLogReader reader{path};
+    EventLogEntry entry;
+    CHECK(reader.next(&entry));
+    CHECK(!reader.next(&entry));
+  }
+
+  SECTION("ShouldNotOpenMissingFiles") {
+    EventLogReader reader{path + ".missing"};
+    CHECK(!reader.is_open());
+  }
+
+  std::remove(path.c_str());
+}
+
+}  // namespace simon::framework
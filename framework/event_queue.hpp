@@ -2,14 +2,24 @@
 
 #pragma once
 
+#include <algorithm>
+#include <format>
 #include <functional>
 #include <iostream>
 #include <map>
-#include <queue>
+#include <memory>
+#include <set>
+#include <span>
 #include <type_traits>
+#include <vector>
 
+#include "base/core.hpp"
+#include "base/memory.hpp"
 #include "base/time.hpp"
+#include "base/trace.hpp"
 #include "framework/event.hpp"
+#include "framework/event_log.hpp"
+#include "framework/snapshot.hpp"
 
 namespace simon::framework {
 
@@ -17,7 +27,7 @@ class EventQueue final {
  public:
   EventQueue() {
     // Install the bespoke timer handler.
-    handlers_[Event<Timer>::name()].emplace_back([](TimePoint time, const EventBase* base) {
+    handlers_of(Event<Timer>::name()).emplace_back([](TimePoint time, const EventBase* base) {
       auto* event = dynamic_cast<const Event<Timer>*>(base);
       event->data().action(time);
     });
@@ -33,7 +43,7 @@ class EventQueue final {
     static_assert(std::is_same_v<MessageType, std::remove_cvref_t<MessageType>>,
                   "Unsupported: cv-ref qualified messages");
 
-    handlers_[Event<MessageType>::name()].emplace_back(
+    handlers_of(Event<MessageType>::name()).emplace_back(
       [msg_handler = std::forward<HandlerType>(handler)](TimePoint time, const EventBase* base) {
         auto* event = dynamic_cast<const Event<MessageType>*>(base);
         msg_handler(time, event->data());
@@ -45,17 +55,132 @@ class EventQueue final {
     static_assert(std::is_same_v<MessageType, std::remove_cvref_t<MessageType>>,
                   "Unsupported: cv-ref qualified messages");
 
-    events_.emplace(
-      std::make_unique<Event<MessageType>>(time, std::forward<DeducedMessageArgs>(args)...));
+    auto event = make_event<MessageType>(time, std::forward<DeducedMessageArgs>(args)...);
+    if constexpr (SnapshotValue<MessageType>) {
+      if (log_ && logged_.contains(Event<MessageType>::name())) [[unlikely]] {
+        log_->append(time, static_cast<const Event<MessageType>&>(*event).data());
+      }
+    }
+    events_.emplace_back(std::move(event));
+    std::push_heap(events_.begin(), events_.end(), Compare{});
+  }
+
+  // While recording, every published message of a type registered with
+  // `save_with_logs()` is appended to `log`, e.g. for `EventReplay`. Pass
+  // nullptr to stop.
+  void record(EventLogWriter* log) { log_ = log; }
+
+  // Published messages of a registered type are recorded while recording.
+  // Messages must be plain values: pointers would not survive a replay.
+  template <SnapshotValue MessageType>
+  void save_with_logs() {
+    logged_.insert(Event<MessageType>::name());
+  }
+
+  // Returns how many events were processed.
+  std::size_t process_until(TimePoint time) {
+    TRACE_SPAN("events", "process_until");
+    std::size_t processed = 0;
+    for (; events_.size() && events_.front()->time() <= time; ++processed) {
+      // Take the event off the heap first, so handlers may publish.
+      std::pop_heap(events_.begin(), events_.end(), Compare{});
+      auto event = std::move(events_.back());
+      events_.pop_back();
+
+      auto handlers = handlers_.find(event->event_name());
+      if (handlers != handlers_.end()) {
+        for (auto& handler : handlers->second) {
+          handler(time, event.get());
+        }
+      }
+    }
+    return processed;
+  }
+
+  std::size_t size() const { return events_.size(); }
+  // Drops every pending event; handlers stay subscribed.
+  void clear() { events_.clear(); }
+
+  // What pending events and handlers take. Handlers that do not fit within
+  // `std::function` are allocated by it, out of sight.
+  MemoryUsage memory_usage() const {
+    std::size_t handler_count = 0;
+    for (auto& [name, handlers] : handlers_) {
+      handler_count += handlers.size();
+    }
+    return {.reserved = memory_.reserved() + event_memory_.reserved(),
+            .in_use = events_.size() * sizeof(EventPointer) + event_memory_.reserved() +
+                      handlers_.size() * sizeof(HandlerMap::value_type) +
+                      handler_count * sizeof(Handler),
+            .allocations = memory_.allocations() + event_memory_.allocations()};
+  }
+  void begin_memory_step() {
+    memory_.begin_step();
+    event_memory_.begin_step();
+  }
+
+  // Pending events of a registered message type are saved with snapshots.
+  // Messages must be plain values: pointers would not survive a restore.
+  template <SnapshotValue MessageType>
+  void save_with_snapshots() {
+    static const SnapshotTag times_tag =
+      snapshot_tag(std::format("event/{}/times", to_type_string<MessageType>()));
+    static const SnapshotTag messages_tag =
+      snapshot_tag(std::format("event/{}/messages", to_type_string<MessageType>()));
+
+    snapshot_codecs_[Event<MessageType>::name()] = SnapshotCodec{
+      .save =
+        [](std::span<const EventBase* const> events, SnapshotWriter* writer) {
+          std::vector<TimePoint::rep> times;
+          std::vector<MessageType> messages;
+          for (auto* base : events) {
+            auto* event = static_cast<const Event<MessageType>*>(base);
+            times.push_back(event->time().time_since_epoch().count());
+            messages.push_back(event->data());
+          }
+          writer->write(times_tag, std::span<const TimePoint::rep>{times});
+          writer->write(messages_tag, std::span<const MessageType>{messages});
+        },
+      .restore =
+        [](const SnapshotReader& reader, EventQueue* queue) {
+          auto times = reader.section<TimePoint::rep>(times_tag);
+          auto messages = reader.section<MessageType>(messages_tag);
+          if (times.size() != messages.size()) {
+            return false;
+          }
+          for (std::size_t i = 0; i < times.size(); ++i) {
+            queue->publish<MessageType>(TimePoint{Duration{times[i]}}, messages[i]);
+          }
+          return true;
+        },
+    };
   }
 
-  void process_until(TimePoint time) {
-    while (events_.size() && events_.top()->time() <= time) {
-      for (auto& handler : handlers_[events_.top()->event_name()]) {
-        handler(time, events_.top().get());
+  // Saves pending events of registered message types; others are skipped.
+  // Returns how many events were saved.
+  std::size_t save(SnapshotWriter* writer) const {
+    std::size_t saved = 0;
+    for (auto& [name, codec] : snapshot_codecs_) {
+      std::vector<const EventBase*> pending;
+      for (auto& event : events_) {
+        if (event->event_name() == name) {
+          pending.push_back(event.get());
+        }
       }
-      events_.pop();
+      codec.save(pending, writer);
+      saved += pending.size();
     }
+    return saved;
+  }
+
+  // Replaces all pending events with those saved for registered types.
+  bool restore(const SnapshotReader& reader) {
+    events_.clear();
+    bool restored = true;
+    for (auto& [name, codec] : snapshot_codecs_) {
+      restored &= codec.restore(reader, this);
+    }
+    return restored;
   }
 
  private:
@@ -63,15 +188,67 @@ class EventQueue final {
     std::function<void(TimePoint)> action;
   };
 
+  // Events are allocated from their own account, so that the bytes of those pending are known
+  // without asking each for its size. Deleting one needs its type, which the deleter keeps.
+  struct EventDeleter final {
+    MemoryAccount* account = nullptr;
+    void (*destroy)(EventBase*, MemoryAccount*) = nullptr;
+
+    void operator()(EventBase* event) const { destroy(event, account); }
+  };
+  using EventPointer = std::unique_ptr<EventBase, EventDeleter>;
+
+  using Handler = std::function<void(TimePoint, const EventBase*)>;
+  using Handlers = std::vector<Handler, CountingAllocator<Handler>>;
+  using HandlerMap = std::map<EventName,
+                              Handlers,
+                              std::less<EventName>,
+                              CountingAllocator<std::pair<const EventName, Handlers>>>;
+
+  // Orders the earliest event on top of the heap.
   struct Compare final {
-    bool operator()(const std::unique_ptr<EventBase>& a, const std::unique_ptr<EventBase>& b) {
-      return a->time() < b->time();
+    bool operator()(const EventPointer& a, const EventPointer& b) {
+      return b->time() < a->time();
     }
   };
 
-  std::priority_queue<std::unique_ptr<EventBase>, std::vector<std::unique_ptr<EventBase>>, Compare>
-    events_;
-  std::map<EventName, std::vector<std::function<void(TimePoint, const EventBase*)>>> handlers_;
+  template <typename MessageType, typename... Args>
+  EventPointer make_event(TimePoint time, Args&&... args) {
+    CountingAllocator<Event<MessageType>> allocator{&event_memory_};
+    auto* event = allocator.allocate(1);
+    try {
+      std::construct_at(event, time, std::forward<Args>(args)...);
+    } catch (...) {
+      allocator.deallocate(event, 1);
+      throw;
+    }
+    return EventPointer{event, EventDeleter{&event_memory_, &destroy_event<MessageType>}};
+  }
+
+  template <typename MessageType>
+  static void destroy_event(EventBase* base, MemoryAccount* account) {
+    auto* event = static_cast<Event<MessageType>*>(base);
+    std::destroy_at(event);
+    CountingAllocator<Event<MessageType>>{account}.deallocate(event, 1);
+  }
+
+  Handlers& handlers_of(EventName name) {
+    return handlers_.try_emplace(name, CountingAllocator<Handler>{&memory_}).first->second;
+  }
+
+  struct SnapshotCodec final {
+    void (*save)(std::span<const EventBase* const>, SnapshotWriter*) = nullptr;
+    bool (*restore)(const SnapshotReader&, EventQueue*) = nullptr;
+  };
+
+  MemoryAccount memory_;
+  MemoryAccount event_memory_;
+  std::vector<EventPointer, CountingAllocator<EventPointer>> events_{  // Heap ordered by Compare.
+    CountingAllocator<EventPointer>{&memory_}};
+  HandlerMap handlers_{CountingAllocator<HandlerMap::value_type>{&memory_}};
+  std::map<EventName, SnapshotCodec> snapshot_codecs_;
+  std::set<EventName> logged_;
+  EventLogWriter* log_ = nullptr;
 };
 
 }  // namespace simon::framework
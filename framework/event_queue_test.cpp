@@ -2,14 +2,18 @@
 
 #include "framework/event_queue.hpp"
 
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
 #include "base/testing.hpp"
 
 namespace simon::framework {
 
 TEST_CASE("EventQueue") {
   EventQueue events;
-  TimePoint start{Duration{0.0}};
-  TimePoint later{Duration{1.0}};
+  TimePoint start{from_seconds(0.0)};
+  TimePoint later{from_seconds(1.0)};
 
   struct M {
     int value = 0;
@@ -23,16 +27,56 @@ TEST_CASE("EventQueue") {
       called = true;
     });
 
-    events.process_until(start);
+    CHECK(events.process_until(start) == 0);
     CHECK(!called);
 
     events.publish<M>(later, mesg);
     CHECK(!called);
 
-    events.process_until(later);
+    CHECK(events.process_until(later) == 1);
     CHECK(called);
   }
 
+  SECTION("ShouldAccountPendingEvents") {
+    auto before = events.memory_usage();
+
+    events.begin_memory_step();
+    events.publish<M>(later, mesg);
+
+    auto pending = events.memory_usage();
+    CHECK(pending.in_use >= before.in_use + sizeof(Event<M>));
+    CHECK(pending.reserved >= before.reserved + sizeof(Event<M>));
+    CHECK(pending.allocations >= 1);
+
+    events.process_until(later);
+    CHECK(events.memory_usage().in_use < pending.in_use);
+  }
+
+  SECTION("ShouldProcessEventsInTimeOrder") {
+    std::vector<int> order;
+    events.subscribe<M>([&order](auto time, M mesg) { order.push_back(mesg.value); });
+
+    events.publish<M>(later, M{2});
+    events.publish<M>(start, M{1});
+    events.publish<M>(later + from_seconds(1.0), M{3});
+    events.process_until(later + from_seconds(1.0));
+
+    CHECK(order == std::vector<int>{1, 2, 3});
+  }
+
+  SECTION("ShouldNotStallBehindLaterEvents") {
+    std::vector<int> order;
+    events.subscribe<M>([&order](auto time, M mesg) { order.push_back(mesg.value); });
+
+    events.publish<M>(later, M{2});
+    events.publish<M>(later + from_seconds(1.0), M{3});
+    events.publish<M>(start, M{1});
+
+    CHECK(events.process_until(start) == 1);
+    CHECK(order == std::vector<int>{1});
+    CHECK(events.size() == 2);
+  }
+
   SECTION("ShouldCallImmidateTimers") {
     bool called = false;
     events.start_timer(start, [&called](auto time) { called = true; });
@@ -48,5 +92,75 @@ TEST_CASE("EventQueue") {
     events.process_until(later);
     CHECK(called);
   }
+
+  SECTION("ShouldRecordPublishedEvents") {
+    const std::string path = std::filesystem::temp_directory_path() / "event_queue_test.log";
+    {
+      EventLogWriter log{path};
+      events.save_with_logs<M>();
+      events.record(&log);
+      events.publish<M>(later, mesg);
+      events.record(nullptr);
+      events.publish<M>(later, mesg);
+    }
+
+    EventLogReader reader{path};
+    EventLogEntry entry;
+    REQUIRE(reader.next(&entry));
+    CHECK(entry.tag == event_log_tag<M>());
+    CHECK(entry.time == later);
+    CHECK(!reader.next(&entry));
+
+    std::remove(path.c_str());
+  }
+
+  SECTION("ShouldRecordOnlyRegisteredEvents") {
+    struct Unregistered {
+      const M* pointer = nullptr;
+    };
+    const std::string path = std::filesystem::temp_directory_path() / "event_queue_test.log";
+    {
+      EventLogWriter log{path};
+      events.save_with_logs<M>();
+      events.record(&log);
+      events.publish<Unregistered>(later, Unregistered{&mesg});
+      events.publish<M>(later, mesg);
+      events.record(nullptr);
+    }
+
+    EventLogReader reader{path};
+    EventLogEntry entry;
+    REQUIRE(reader.next(&entry));
+    CHECK(entry.tag == event_log_tag<M>());
+    CHECK(!reader.next(&entry));
+
+    std::remove(path.c_str());
+  }
+
+  SECTION("ShouldRestoreRegisteredPendingEvents") {
+    const std::string path = std::filesystem::temp_directory_path() / "event_queue_test.snap";
+    events.save_with_snapshots<M>();
+    events.publish<M>(later, mesg);
+    events.start_timer(later, [](auto time) {});
+
+    SnapshotWriter writer{path};
+    CHECK(events.save(&writer) == 1);
+    REQUIRE(writer.finish());
+
+    EventQueue restored;
+    restored.save_with_snapshots<M>();
+    SnapshotReader reader{path};
+    REQUIRE(restored.restore(reader));
+    CHECK(restored.size() == 1);
+
+    int value = 0;
+    restored.subscribe<M>([&value](auto time, M mesg) { value = mesg.value; });
+    restored.process_until(start);
+    CHECK(value == 0);
+    restored.process_until(later);
+    CHECK(value == 5);
+
+    std::remove(path.c_str());
+  }
 }
 }  // namespace simon::framework
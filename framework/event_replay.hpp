@@ -0,0 +1,74 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/time.hpp"
+#include "framework/event_log.hpp"
+#include "framework/event_queue.hpp"
+#include "framework/snapshot.hpp"
+
+namespace simon::framework {
+
+// Feeds the events of a recorded log back into a queue at their original
+// times. Only message types registered with `replay()` are published, which is
+// how a replay picks the inputs of a run out from everything the run published
+// itself. Records are logged in publish order, and a handler may publish an
+// event further in the future than those published after it, so the whole log
+// is read up front and replayed in time order, ties in publish order.
+class EventReplay final {
+ public:
+  explicit EventReplay(const std::string& path) : reader_{path} {
+    for (EventLogEntry entry; reader_.next(&entry);) {
+      entries_.push_back(std::move(entry));
+    }
+    std::stable_sort(entries_.begin(), entries_.end(), [](const auto& a, const auto& b) {
+      return a.time < b.time;
+    });
+  }
+
+  bool is_open() const { return reader_.is_open(); }
+  // True once every recorded event has been published or skipped.
+  bool done() const { return next_ == entries_.size(); }
+
+  template <SnapshotValue MessageType>
+  void replay() {
+    publishers_[event_log_tag<MessageType>()] = [](TimePoint time,
+                                                   std::span<const std::byte> payload,
+                                                   EventQueue* events) {
+      MessageType message;
+      if (payload.size() == sizeof(message)) {
+        std::memcpy(&message, payload.data(), sizeof(message));
+        events->publish<MessageType>(time, message);
+      }
+    };
+  }
+
+  // Publishes every recorded event up to and including `time`.
+  void publish_until(TimePoint time, EventQueue* events) {
+    for (; next_ < entries_.size() && entries_[next_].time <= time; ++next_) {
+      const EventLogEntry& entry = entries_[next_];
+      auto publisher = publishers_.find(entry.tag);
+      if (publisher != publishers_.end()) {
+        publisher->second(entry.time, entry.payload, events);
+      }
+    }
+  }
+
+ private:
+  EventLogReader reader_;
+  std::vector<EventLogEntry> entries_;  // By time.
+  std::size_t next_ = 0;
+  std::unordered_map<SnapshotTag,
+                     std::function<void(TimePoint, std::span<const std::byte>, EventQueue*)>>
+    publishers_;
+};
+
+}  // namespace simon::framework
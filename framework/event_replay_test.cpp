@@ -0,0 +1,94 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "framework/event_replay.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+#include "base/testing.hpp"
+
+namespace simon::framework {
+
+TEST_CASE("EventReplay") {
+  const std::string path = std::filesystem::temp_directory_path() / "event_replay_test.log";
+  TimePoint start{from_seconds(0.0)};
+  TimePoint later{from_seconds(1.0)};
+
+  struct Input {
+    int value = 0;
+  };
+  struct Output {
+    int value = 0;
+  };
+
+  {
+    EventLogWriter log{path};
+    EventQueue recorded;
+    recorded.save_with_logs<Input>();
+    recorded.save_with_logs<Output>();
+    recorded.record(&log);
+    recorded.publish<Input>(start, Input{1});
+    recorded.publish<Output>(start, Output{2});
+    recorded.publish<Input>(later, Input{3});
+    recorded.start_timer(later, [](auto time) {});
+  }
+
+  EventQueue events;
+  EventReplay replay{path};
+  REQUIRE(replay.is_open());
+  replay.replay<Input>();
+
+  std::vector<int> inputs;
+  events.subscribe<Input>([&inputs](auto time, Input input) { inputs.push_back(input.value); });
+  bool output = false;
+  events.subscribe<Output>([&output](auto time, Output) { output = true; });
+
+  SECTION("ShouldPublishRecordedInputsAtTheirTimes") {
+    replay.publish_until(start, &events);
+    events.process_until(start);
+    CHECK(inputs == std::vector<int>{1});
+    CHECK(!replay.done());
+
+    replay.publish_until(later, &events);
+    events.process_until(later);
+    CHECK(inputs == std::vector<int>{1, 3});
+    CHECK(replay.done());
+  }
+
+  SECTION("ShouldPublishInTimeOrderWhateverThePublishOrder") {
+    const std::string unordered_path =
+      std::filesystem::temp_directory_path() / "event_replay_test_unordered.log";
+    {
+      EventLogWriter log{unordered_path};
+      EventQueue recorded;
+      recorded.save_with_logs<Input>();
+      recorded.record(&log);
+      recorded.publish<Input>(later, Input{2});
+      recorded.publish<Input>(start, Input{1});
+    }
+    EventReplay unordered{unordered_path};
+    unordered.replay<Input>();
+
+    unordered.publish_until(start, &events);
+    events.process_until(start);
+    CHECK(inputs == std::vector<int>{1});
+    CHECK(!unordered.done());
+
+    unordered.publish_until(later, &events);
+    events.process_until(later);
+    CHECK(inputs == std::vector<int>{1, 2});
+    CHECK(unordered.done());
+    std::remove(unordered_path.c_str());
+  }
+
+  SECTION("ShouldNotPublishUnregisteredTypes") {
+    replay.publish_until(later, &events);
+    events.process_until(later);
+    CHECK(!output);
+  }
+
+  std::remove(path.c_str());
+}
+
+}  // namespace simon::framework
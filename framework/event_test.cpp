@@ -5,6 +5,7 @@
 #include <type_traits>
 
 #include "base/testing.hpp"
+#include "base/type_registry.hpp"
 
 namespace simon::framework {
 
@@ -28,6 +29,29 @@ TEST_CASE("Event") {
     CHECK(static_cast<EventBase*>(&e)->event_name() == Event<M>::name());
   }
 
+  SECTION("ShouldHaveNameHashedFromTypeName") {
+    CHECK(Event<M>::name().value() == stable_hash(to_type_name<M>()));
+  }
+
+  SECTION("ShouldBeRecordedByName") {
+    const TypeRecord* record = TypeRegistry::instance().find(Event<M>::name().value());
+    REQUIRE(record != nullptr);
+    CHECK(record->name == to_type_string<M>());
+  }
+
+  SECTION("ShouldHaveConstantNameForDispatch") {
+    struct Other final {};
+    bool dispatched = false;
+    switch (e.event_name().value()) {
+      case Event<M>::name().value():
+        dispatched = true;
+        break;
+      case Event<Other>::name().value():
+        break;
+    }
+    CHECK(dispatched);
+  }
+
   SECTION("ShouldHaveSameTimePoint") {
     CHECK(e.time() == t);
   }
@@ -5,8 +5,11 @@
 #include <cstddef>
 #include <memory>
 #include <ostream>
+#include <utility>
 
+#include "base/core.hpp"
 #include "base/type_macros.hpp"
+#include "base/type_registry.hpp"
 
 namespace simon::framework {
 
@@ -16,13 +19,21 @@ class Name {
  public:
   DECLARE_NON_DEFAULTABLE(Name);
 
-  bool operator==(const Name& that) const { return name_ == that.name_; }
-  bool operator!=(const Name& that) const { return name_ != that.name_; }
-  bool operator<(const Name& that) const { return name_ < that.name_; }
+  constexpr bool operator==(const Name& that) const {
+    return name_ == that.name_;
+  }
+  constexpr bool operator!=(const Name& that) const {
+    return name_ != that.name_;
+  }
+  constexpr bool operator<(const Name& that) const {
+    return name_ < that.name_;
+  }
+
+  constexpr std::size_t value() const { return name_; }
 
  private:
   friend class Identity;
-  Name(std::size_t name) : name_{name} {}
+  constexpr Name(std::size_t name) : name_{name} {}
   std::size_t name_ = 0;
 
   friend std::ostream& operator<<(std::ostream& out, Name name) {
@@ -36,7 +47,9 @@ class Identity {
   DECLARE_MOVE_ONLY(Identity);
 
   Identity();
-  Name name() const { return Name{id_}; }
+  // Reissues an identity previously read from `Name::value()`, e.g. on restore.
+  constexpr explicit Identity(std::size_t id) : id_{id} {}
+  constexpr Name name() const { return Name{id_}; }
   bool operator==(const Identity& that) const { return name() == that.name(); }
   bool operator!=(const Identity& that) const { return name() != that.name(); }
   bool operator<(const Identity& that) const { return name() < that.name(); }
@@ -46,17 +59,29 @@ class Identity {
 };
 
 class PerObjectIdentity {
+ public:
+  PerObjectIdentity() = default;
+  explicit PerObjectIdentity(Identity id) : id_{std::move(id)} {}
+
  protected:
   Identity id_;
 };
 
+// Hashed from the type's name at compile time, so that it is the same in every
+// process and a constant expression. Distinct types are assumed not to collide
+// in 64 bits. Every type with instances is recorded in the `TypeRegistry` at
+// startup, so that tools can name any id.
 template <typename Type>
 class PerTypeIdentity {
  protected:
-  static const Identity& id() {
-    static Identity id_;
-    return id_;
+  PerTypeIdentity() { static_cast<void>(static_record_); }
+
+  static constexpr Identity id() {
+    return Identity{stable_hash(to_type_name<Type>())};
   }
+
+ private:
+  static inline const TypeRecord& static_record_ = type_record<Type>();
 };
 
 }  // namespace simon::framework
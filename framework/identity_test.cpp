@@ -69,6 +69,11 @@ TEST_CASE("Identity") {
     REQUIRE(identity.name() == identity.name());
   }
 
+  SECTION("ShouldReissueSameNameFromValue") {
+    Identity identity;
+    REQUIRE(Identity{identity.name().value()}.name() == identity.name());
+  }
+
   SECTION("ShouldNotCompareLessNamesForSameIdentities") {
     Identity identity;
     REQUIRE(!(identity.name() < identity.name()));
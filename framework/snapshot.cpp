@@ -0,0 +1,129 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "framework/snapshot.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstring>
+
+namespace simon::framework {
+namespace {
+constexpr char SNAPSHOT_MAGIC[8] = {'S', 'I', 'M', 'O', 'N', 'S', 'N', 'P'};
+
+std::uint64_t align_up(std::uint64_t offset) {
+  return (offset + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+}
+}  // namespace
+
+SnapshotWriter::SnapshotWriter(const std::string& path) : file_{std::fopen(path.c_str(), "wb")} {
+  // Reserve the header, left zeroed until finish() so that a partially written
+  // file is never mistaken for a snapshot.
+  SnapshotHeader header{};
+  failed_ = !file_ || std::fwrite(&header, sizeof(header), 1, file_) != 1;
+  offset_ = sizeof(header);
+}
+
+SnapshotWriter::~SnapshotWriter() {
+  if (file_) {
+    std::fclose(file_);
+  }
+}
+
+void SnapshotWriter::write_bytes(SnapshotTag tag,
+                                 const void* data,
+                                 std::size_t size,
+                                 std::size_t element_size) {
+  if (failed_) {
+    return;
+  }
+
+  static constexpr std::array<char, SNAPSHOT_ALIGNMENT> padding{};
+  std::uint64_t aligned = align_up(offset_);
+  failed_ |= std::fwrite(padding.data(), 1, aligned - offset_, file_) != aligned - offset_;
+  failed_ |= std::fwrite(data, 1, size, file_) != size;
+  sections_.push_back({.tag = tag, .offset = aligned, .size = size, .element_size = element_size});
+  offset_ = aligned + size;
+}
+
+bool SnapshotWriter::finish() {
+  if (failed_) {
+    return false;
+  }
+
+  SnapshotHeader header{};
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+  header.version = SNAPSHOT_VERSION;
+  header.section_count = static_cast<std::uint32_t>(sections_.size());
+  header.table_offset = offset_;
+
+  failed_ |= std::fwrite(sections_.data(), sizeof(SnapshotSection), sections_.size(), file_) !=
+             sections_.size();
+  failed_ |= std::fseek(file_, 0, SEEK_SET) != 0;
+  failed_ |= std::fwrite(&header, sizeof(header), 1, file_) != 1;
+  failed_ |= std::fclose(file_) != 0;
+  file_ = nullptr;
+  return !failed_;
+}
+
+SnapshotReader::SnapshotReader(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+
+  struct stat status {};
+  void* mapped = MAP_FAILED;
+  if (::fstat(fd, &status) == 0 && status.st_size >= static_cast<off_t>(sizeof(SnapshotHeader))) {
+    // Restores read every section whole, so the pages are mapped up front rather than faulted in
+    // one at a time.
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    flags |= MAP_POPULATE;
+#endif
+    mapped = ::mmap(nullptr, status.st_size, PROT_READ, flags, fd, 0);
+  }
+  ::close(fd);
+  if (mapped == MAP_FAILED) {
+    return;
+  }
+
+  const auto* data = static_cast<const std::byte*>(mapped);
+  const std::size_t size = status.st_size;
+
+  SnapshotHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  const std::uint64_t table_size = std::uint64_t{header.section_count} * sizeof(SnapshotSection);
+  bool valid = std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0 &&
+               header.version == SNAPSHOT_VERSION && header.table_offset <= size &&
+               table_size <= size - header.table_offset;
+
+  for (std::uint32_t i = 0; valid && i < header.section_count; ++i) {
+    SnapshotSection section;
+    std::memcpy(&section, data + header.table_offset + i * sizeof(section), sizeof(section));
+    valid = section.offset % SNAPSHOT_ALIGNMENT == 0 && section.offset <= header.table_offset &&
+            section.size <= header.table_offset - section.offset && section.element_size > 0 &&
+            section.size % section.element_size == 0;
+    sections_[section.tag] = section;
+  }
+
+  if (!valid) {
+    sections_.clear();
+    ::munmap(mapped, size);
+    return;
+  }
+
+  data_ = data;
+  size_ = size;
+}
+
+SnapshotReader::~SnapshotReader() {
+  if (data_) {
+    ::munmap(const_cast<std::byte*>(data_), size_);
+  }
+}
+
+}  // namespace simon::framework
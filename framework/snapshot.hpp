@@ -0,0 +1,115 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "base/core.hpp"
+
+namespace simon::framework {
+
+// Snapshot files are a header, a run of sections and a section table. Every
+// section payload is a packed array of fixed-size values starting on a 64 byte
+// boundary, so a reader maps the file and hands out spans into it directly
+// instead of parsing values one at a time.
+//
+//   SnapshotHeader | section payloads (64 byte aligned) | SnapshotSection[]
+//
+constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+constexpr std::size_t SNAPSHOT_ALIGNMENT = 64;
+
+struct SnapshotHeader final {
+  char magic[8];
+  std::uint32_t version = 0;
+  std::uint32_t section_count = 0;
+  std::uint64_t table_offset = 0;
+};
+
+struct SnapshotSection final {
+  std::uint64_t tag = 0;
+  std::uint64_t offset = 0;
+  std::uint64_t size = 0;
+  std::uint64_t element_size = 0;
+};
+
+using SnapshotTag = std::uint64_t;
+
+constexpr SnapshotTag snapshot_tag(std::string_view name) { return stable_hash(name); }
+
+// Values whose bytes are their value: trivially copyable types, and fixed-size
+// Eigen vectors and matrices, which hold a plain array but declare copies.
+template <typename Type>
+concept SnapshotValue =
+  std::is_trivially_copyable_v<Type> ||
+  (std::is_standard_layout_v<Type> && requires { typename Type::Scalar; } &&
+   (Type::SizeAtCompileTime > 0) &&
+   sizeof(Type) == sizeof(typename Type::Scalar) * Type::SizeAtCompileTime);
+
+class SnapshotWriter final {
+ public:
+  explicit SnapshotWriter(const std::string& path);
+  ~SnapshotWriter();
+
+  SnapshotWriter(const SnapshotWriter&) = delete;
+  SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+  bool is_open() const { return file_ != nullptr; }
+
+  template <SnapshotValue ValueType>
+  void write(SnapshotTag tag, std::span<const ValueType> values) {
+    write_bytes(tag, values.data(), values.size_bytes(), sizeof(ValueType));
+  }
+
+  // Writes the section table and header. Until then the file is not readable.
+  bool finish();
+
+ private:
+  void write_bytes(SnapshotTag tag, const void* data, std::size_t size, std::size_t element_size);
+
+  std::FILE* file_ = nullptr;
+  std::uint64_t offset_ = 0;
+  bool failed_ = false;
+  std::vector<SnapshotSection> sections_;
+};
+
+class SnapshotReader final {
+ public:
+  explicit SnapshotReader(const std::string& path);
+  ~SnapshotReader();
+
+  SnapshotReader(const SnapshotReader&) = delete;
+  SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+  // True if the file is mapped and is a complete snapshot of this version.
+  bool is_open() const { return data_ != nullptr; }
+
+  bool contains(SnapshotTag tag) const { return sections_.contains(tag); }
+
+  // A view directly into the mapped file, valid while the reader lives. Empty
+  // if there is no such section or it holds values of a different size.
+  template <SnapshotValue ValueType>
+  std::span<const ValueType> section(SnapshotTag tag) const {
+    auto iter = sections_.find(tag);
+    if (iter == sections_.end() || iter->second.element_size != sizeof(ValueType)) {
+      return {};
+    }
+    static_assert(alignof(ValueType) <= SNAPSHOT_ALIGNMENT);
+    return {reinterpret_cast<const ValueType*>(data_ + iter->second.offset),
+            iter->second.size / sizeof(ValueType)};
+  }
+
+ private:
+  const std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::unordered_map<SnapshotTag, SnapshotSection> sections_;
+};
+
+}  // namespace simon::framework
@@ -0,0 +1,78 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "framework/snapshot.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+#include "base/math.hpp"
+#include "base/testing.hpp"
+
+namespace simon::framework {
+
+TEST_CASE("Snapshot") {
+  const std::string path = std::filesystem::temp_directory_path() / "snapshot_test.snap";
+  const SnapshotTag numbers_tag = snapshot_tag("numbers");
+  const SnapshotTag vectors_tag = snapshot_tag("vectors");
+  const std::vector<int> numbers{1, 2, 3};
+  const std::vector<Vec3> vectors{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+
+  SECTION("ShouldReadBackWrittenSections") {
+    SnapshotWriter writer{path};
+    REQUIRE(writer.is_open());
+    writer.write(numbers_tag, std::span<const int>{numbers});
+    writer.write(vectors_tag, std::span<const Vec3>{vectors});
+    REQUIRE(writer.finish());
+
+    SnapshotReader reader{path};
+    REQUIRE(reader.is_open());
+    auto read_numbers = reader.section<int>(numbers_tag);
+    auto read_vectors = reader.section<Vec3>(vectors_tag);
+    CHECK(std::vector<int>(read_numbers.begin(), read_numbers.end()) == numbers);
+    REQUIRE(read_vectors.size() == 2);
+    CHECK(read_vectors[1] == vectors[1]);
+  }
+
+  SECTION("ShouldAlignSectionPayloads") {
+    SnapshotWriter writer{path};
+    writer.write(numbers_tag, std::span<const int>{numbers});
+    writer.write(vectors_tag, std::span<const Vec3>{vectors});
+    REQUIRE(writer.finish());
+
+    SnapshotReader reader{path};
+    auto address = reinterpret_cast<std::uintptr_t>(reader.section<Vec3>(vectors_tag).data());
+    CHECK(address % SNAPSHOT_ALIGNMENT == 0);
+  }
+
+  SECTION("ShouldNotReadMissingOrMismatchedSections") {
+    SnapshotWriter writer{path};
+    writer.write(numbers_tag, std::span<const int>{numbers});
+    REQUIRE(writer.finish());
+
+    SnapshotReader reader{path};
+    REQUIRE(reader.is_open());
+    CHECK(!reader.contains(vectors_tag));
+    CHECK(reader.section<Vec3>(vectors_tag).empty());
+    CHECK(reader.section<double>(numbers_tag).empty());
+  }
+
+  SECTION("ShouldNotOpenUnfinishedSnapshots") {
+    {
+      SnapshotWriter writer{path};
+      writer.write(numbers_tag, std::span<const int>{numbers});
+    }
+
+    SnapshotReader reader{path};
+    CHECK(!reader.is_open());
+  }
+
+  SECTION("ShouldNotOpenMissingFiles") {
+    SnapshotReader reader{path + ".missing"};
+    CHECK(!reader.is_open());
+  }
+
+  std::remove(path.c_str());
+}
+
+}  // namespace simon::framework
@@ -0,0 +1,58 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <cstddef>
+
+#include "base/time.hpp"
+
+namespace simon::framework {
+
+// How often a system runs relative to the simulation's base step: either a
+// whole number of ticks within every step, or a single tick once every whole
+// number of steps. A system that runs less often takes proportionally larger
+// ticks. Ticks partition the span exactly: when it does not divide evenly into
+// whole clock ticks, the remainder is spread over the ticks rather than lost.
+class TickRate final {
+ public:
+  static constexpr TickRate per_step(std::size_t ticks) { return TickRate{ticks, 1}; }
+  static constexpr TickRate every(std::size_t steps) { return TickRate{1, steps}; }
+
+  constexpr std::size_t ticks_per_step() const { return ticks_; }
+  constexpr std::size_t steps_per_tick() const { return steps_; }
+
+  constexpr bool is_due(std::size_t step_index) const { return step_index % steps_ == 0; }
+  constexpr Duration span(Duration step) const { return step * static_cast<Duration::rep>(steps_); }
+  constexpr Duration tick_size(Duration step) const {
+    return span(step) / static_cast<Duration::rep>(ticks_);
+  }
+
+  // Runs `system` for each of its ticks that fall within step `step_index`.
+  template <typename SystemType, typename EventSink>
+  void operator()(SystemType& system,
+                  std::size_t step_index,
+                  TimePoint time,
+                  Duration step,
+                  EventSink events) const {
+    if (!is_due(step_index)) {
+      return;
+    }
+    const Duration span = this->span(step);
+    const auto ticks = static_cast<Duration::rep>(ticks_);
+    Duration begin{};
+    for (Duration::rep i = 1; i <= ticks; ++i) {
+      Duration end = span * i / ticks;
+      system(time + begin, end - begin, events);
+      begin = end;
+    }
+  }
+
+ private:
+  constexpr TickRate(std::size_t ticks, std::size_t steps)
+    : ticks_{ticks > 0 ? ticks : 1}, steps_{steps > 0 ? steps : 1} {}
+
+  std::size_t ticks_ = 1;
+  std::size_t steps_ = 1;
+};
+
+}  // namespace simon::framework
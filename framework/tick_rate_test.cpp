@@ -0,0 +1,70 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "framework/tick_rate.hpp"
+
+#include <vector>
+
+#include "base/testing.hpp"
+
+namespace simon::framework {
+
+TEST_CASE("TickRate") {
+  struct System final {
+    void operator()(TimePoint time, Duration step, std::nullptr_t) {
+      times.push_back(time);
+      steps.push_back(step);
+    }
+    std::vector<TimePoint> times;
+    std::vector<Duration> steps;
+  } system;
+
+  TimePoint time{from_seconds(1.0)};
+  Duration step = from_seconds(1.0);
+
+  SECTION("ShouldRunEveryStepByDefault") {
+    TickRate rate = TickRate::per_step(1);
+    for (std::size_t i = 0; i < 3; ++i) {
+      rate(system, i, time, step, nullptr);
+    }
+    CHECK(system.times.size() == 3);
+  }
+
+  SECTION("ShouldRunMultipleTicksPerStep") {
+    TickRate rate = TickRate::per_step(4);
+    rate(system, 0, time, step, nullptr);
+
+    REQUIRE(system.times.size() == 4);
+    CHECK(system.times.front() == time);
+    CHECK(system.times.back() == time + from_seconds(0.75));
+    CHECK(system.steps.back() == from_seconds(0.25));
+  }
+
+  SECTION("ShouldRunOnceEveryFewSteps") {
+    TickRate rate = TickRate::every(3);
+    for (std::size_t i = 0; i < 6; ++i) {
+      rate(system, i, time + step * i, step, nullptr);
+    }
+
+    REQUIRE(system.times.size() == 2);
+    CHECK(system.times[0] == time);
+    CHECK(system.times[1] == time + step * 3);
+    CHECK(system.steps.back() == step * 3);
+  }
+
+  SECTION("ShouldCoverStepExactlyWhenNotEvenlyDivisible") {
+    TickRate rate = TickRate::per_step(3);
+    Duration uneven{10};
+    rate(system, 0, time, uneven, nullptr);
+
+    REQUIRE(system.steps.size() == 3);
+    CHECK(system.steps[0] + system.steps[1] + system.steps[2] == uneven);
+    CHECK(system.times.back() + system.steps.back() == time + uneven);
+  }
+
+  SECTION("ShouldNotAllowZeroRates") {
+    CHECK(TickRate::per_step(0).ticks_per_step() == 1);
+    CHECK(TickRate::every(0).steps_per_tick() == 1);
+  }
+}
+
+}  // namespace simon::framework
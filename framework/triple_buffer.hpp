@@ -0,0 +1,58 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace simon::framework {
+
+// Single-producer, single-consumer triple buffer. The writer fills its private
+// buffer and publishes it; the reader acquires the most recently published
+// buffer. Neither side ever blocks on the other: a slow reader only skips
+// intermediate values and a slow writer only leaves the reader on a stale one.
+template <typename ValueType>
+class TripleBuffer final {
+ public:
+  TripleBuffer() = default;
+
+  TripleBuffer(const TripleBuffer&) = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+  // Writer side.
+  ValueType& write_buffer() { return slots_[write_].value; }
+
+  void publish() {
+    auto previous = shared_.exchange(write_ | FRESH_BIT, std::memory_order_acq_rel);
+    write_ = previous & INDEX_MASK;
+  }
+
+  // Reader side. Returns true if a newer value was published since last time.
+  bool acquire() {
+    if (!(shared_.load(std::memory_order_relaxed) & FRESH_BIT)) {
+      return false;
+    }
+    auto previous = shared_.exchange(read_, std::memory_order_acq_rel);
+    read_ = previous & INDEX_MASK;
+    return true;
+  }
+
+  const ValueType& read_buffer() const { return slots_[read_].value; }
+
+ private:
+  static constexpr std::uint8_t INDEX_MASK = 0b011;
+  static constexpr std::uint8_t FRESH_BIT = 0b100;
+  static constexpr std::size_t CACHE_LINE = 64;
+
+  struct alignas(CACHE_LINE) Slot final {
+    ValueType value;
+  };
+
+  std::array<Slot, 3> slots_;
+  alignas(CACHE_LINE) std::uint8_t write_ = 0;
+  alignas(CACHE_LINE) std::atomic<std::uint8_t> shared_ = 1;
+  alignas(CACHE_LINE) std::uint8_t read_ = 2;
+};
+
+}  // namespace simon::framework
@@ -0,0 +1,75 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "framework/triple_buffer.hpp"
+
+#include <thread>
+
+#include "base/testing.hpp"
+
+namespace simon::framework {
+
+TEST_CASE("TripleBuffer") {
+  TripleBuffer<int> buffer;
+
+  SECTION("ShouldNotAcquireBeforePublish") {
+    CHECK(!buffer.acquire());
+  }
+
+  SECTION("ShouldAcquirePublishedValue") {
+    buffer.write_buffer() = 5;
+    buffer.publish();
+
+    REQUIRE(buffer.acquire());
+    CHECK(buffer.read_buffer() == 5);
+  }
+
+  SECTION("ShouldAcquireOnlyOncePerPublish") {
+    buffer.write_buffer() = 5;
+    buffer.publish();
+
+    CHECK(buffer.acquire());
+    CHECK(!buffer.acquire());
+    CHECK(buffer.read_buffer() == 5);
+  }
+
+  SECTION("ShouldAcquireLatestOfManyPublishes") {
+    for (int i = 0; i < 10; ++i) {
+      buffer.write_buffer() = i;
+      buffer.publish();
+    }
+
+    REQUIRE(buffer.acquire());
+    CHECK(buffer.read_buffer() == 9);
+  }
+
+  SECTION("ShouldNotTearAcrossThreads") {
+    struct Pair final {
+      int a = 0;
+      int b = 0;
+    };
+    TripleBuffer<Pair> pairs;
+    constexpr int count = 100'000;
+
+    std::thread writer{[&pairs] {
+      for (int i = 1; i <= count; ++i) {
+        pairs.write_buffer() = Pair{i, -i};
+        pairs.publish();
+      }
+    }};
+
+    int last = 0;
+    bool torn = false;
+    while (last < count) {
+      if (pairs.acquire()) {
+        const auto& pair = pairs.read_buffer();
+        torn |= pair.a != -pair.b || pair.a < last;
+        last = pair.a;
+      }
+    }
+    writer.join();
+
+    CHECK(!torn);
+  }
+}
+
+}  // namespace simon::framework
@@ -1,153 +1,225 @@
 #include <SDL2/SDL.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
+#include <numbers>
+#include <thread>
+#include <vector>
 
 #include "backends/imgui_impl_sdl.h"
 #include "backends/imgui_impl_sdlrenderer.h"
 #include "base/contract.hpp"
+#include "base/memory.hpp"
 #include "base/time.hpp"
 #include "component/controls.hpp"
 #include "component/environment.hpp"
 #include "component/movement.hpp"
 #include "component/physical.hpp"
-#include "framework/component_system.hpp"
-#include "framework/entity.hpp"
-#include "framework/event_queue.hpp"
+#include "framework/triple_buffer.hpp"
 #include "imgui.h"
+#include "simulation/simulation.hpp"
 
 using namespace simon;
-using framework::Entity;
-using framework::EntityName;
+using simulation::BodySnapshot;
+using simulation::Collision;
+using simulation::Simulation;
+using simulation::StepStats;
+
+// Wall time between simulation steps.
+constexpr std::chrono::steady_clock::duration STEP_PERIOD = std::chrono::microseconds{16'667};
+
+// Draws bodies as filled polygons, batched into a few large SDL_RenderGeometry
+// calls. Bodies outside the viewport are skipped and small ones get fewer
+// segments, so the cost follows what is visible rather than the body count.
+class BodyRenderer final {
+ public:
+  static constexpr int MIN_SEGMENTS = 4;
+  static constexpr int MAX_SEGMENTS = 32;
+  static constexpr float MAX_EDGE_LENGTH = 4.0f;  // On-screen pixels.
+  static constexpr std::size_t BATCH_VERTICES = 1 << 16;
+
+  explicit BodyRenderer(SDL_Renderer* renderer) : renderer_{renderer} {
+    unit_circles_.resize(MAX_SEGMENTS + 1);
+    for (int segments = MIN_SEGMENTS; segments <= MAX_SEGMENTS; ++segments) {
+      for (int i = 0; i < segments; ++i) {
+        float angle = 2.0f * std::numbers::pi_v<float> * i / segments;
+        unit_circles_[segments].push_back({std::cos(angle), std::sin(angle)});
+      }
+    }
+    vertices_.reserve(BATCH_VERTICES);
+    indices_.reserve(3 * BATCH_VERTICES);
+  }
 
-struct Collision final {
-  component::Physical* a = nullptr;
-  component::Physical* b = nullptr;
-};
+  void draw(const std::vector<BodySnapshot>& bodies) {
+    int width = 0, height = 0;
+    SDL_GetRendererOutputSize(renderer_, &width, &height);
 
-bool has_collision(component::Physical* a, component::Physical* b) {
-  auto distance = static_cast<Vec3>(a->movement->position - b->movement->position).norm();
-  return distance <= (a->radius + b->radius);
-}
+    for (std::size_t i = 0; i < bodies.size(); ++i) {
+      float x = bodies[i].position[0];
+      float y = bodies[i].position[1];
+      float radius = bodies[i].radius;
+      if (x + radius < 0 || y + radius < 0 || x - radius > width || y - radius > height) {
+        continue;
+      }
 
-struct DetectSphericalCollision : public framework::ComputeBase<component::Physical> {
-  void prepare(component::Physical* current) { others.push_back(current); }
-  void operator()(component::Physical* current,
-                  TimePoint time,
-                  Duration step,
-                  framework::EventQueue* events) {
-    for (auto* other : others) {
-      if (current != other && has_collision(current, other)) {
-        events->publish<Collision>(time, current, other);
+      if (vertices_.size() + MAX_SEGMENTS + 1 > BATCH_VERTICES) {
+        flush();
       }
+      append(x, y, radius, i == 0 ? RED : BLUE);
     }
+    flush();
   }
-  void resolve(component::Physical* current) { others.clear(); }
-  std::vector<component::Physical*> others;
-};
 
-auto compute_acceleration(component::Movement* m) {
-  return m->controls->acceleration +
-         (m->physical->wind_resistance_factor * (m->environment->wind - m->velocity));
-}
+ private:
+  static constexpr SDL_Color RED = {255, 0, 0, 255};
+  static constexpr SDL_Color BLUE = {0, 0, 255, 255};
 
-struct ForwardEulerMovement : public framework::ComputeBase<component::Movement> {
-  void operator()(component::Movement* movement,
-                  TimePoint time,
-                  Duration step,
-                  framework::EventQueue* events) {
-    auto prev = *movement;
-    auto& next = *movement;
-    auto acceleration = compute_acceleration(movement);
-
-    next.velocity = prev.velocity + acceleration * step.count();
-    next.position = prev.position + prev.velocity * step.count();
+  static int segments_for(float radius) {
+    int segments = std::ceil(2.0f * std::numbers::pi_v<float> * radius / MAX_EDGE_LENGTH);
+    return std::clamp(segments, MIN_SEGMENTS, MAX_SEGMENTS);
   }
-};
 
-struct TrapezoidMovement : public framework::ComputeBase<component::Movement> {
-  void operator()(component::Movement* movement,
-                  TimePoint time,
-                  Duration step,
-                  framework::EventQueue* events) {
-    auto prev = *movement;
-    auto& next = *movement;
-    auto acceleration = compute_acceleration(movement);
-
-    next.velocity = prev.velocity + acceleration * step.count();
-    next.position = prev.position + (prev.velocity + next.velocity) * step.count() * 0.5;
+  // Appends a triangle fan around the center.
+  void append(float x, float y, float radius, SDL_Color color) {
+    const int center = vertices_.size();
+    vertices_.push_back({.position = {x, y}, .color = color});
+
+    const auto& circle = unit_circles_[segments_for(radius)];
+    const int segments = circle.size();
+    for (int i = 0; i < segments; ++i) {
+      vertices_.push_back(
+        {.position = {x + radius * circle[i].x, y + radius * circle[i].y}, .color = color});
+      indices_.insert(indices_.end(), {center, center + 1 + i, center + 1 + (i + 1) % segments});
+    }
   }
-};
 
-struct RungeKutta2Movement : public framework::ComputeBase<component::Movement> {
-  void operator()(component::Movement* movement,
-                  TimePoint time,
-                  Duration step,
-                  framework::EventQueue* events) {
-    auto prev = *movement;
-    auto& next = *movement;
-    auto acceleration = compute_acceleration(movement);
-
-    // k1.velocity = prev.velocity + acceleration * step;
-    // mid.velocity = prev.velocity + k1.velocity * step * 0.5;
-    // k2.velocity = mid.velocity + acceleration * step;
-
-    next.velocity = prev.velocity + acceleration * step.count();
-    next.position =
-      prev.position +
-      ((prev.velocity + (prev.velocity + acceleration * step.count()) * step.count() * 0.5) +
-       acceleration * step.count()) *
-        step.count();
+  void flush() {
+    if (!indices_.empty()) {
+      SDL_RenderGeometry(
+        renderer_, nullptr, vertices_.data(), vertices_.size(), indices_.data(), indices_.size());
+    }
+    vertices_.clear();
+    indices_.clear();
   }
+
+  SDL_Renderer* renderer_;
+  std::vector<std::vector<SDL_FPoint>> unit_circles_;  // Indexed by segment count.
+  std::vector<SDL_Vertex> vertices_;
+  std::vector<int> indices_;
 };
 
-struct ComputeMovement : public RungeKutta2Movement {};
+// What the simulation thread hands the overlay after each step while it is shown.
+struct PerfSample final {
+  StepStats step;
+  MemoryUsage memory;  // Of every subsystem.
+};
 
-class Simulation final {
+// The last values of one counter, plotted oldest first.
+class RollingPlot final {
  public:
-  static constexpr Duration STEP_SIZE{0.1};
-  static constexpr double SUB_STEP_FACTOR{0.1};
+  static constexpr int SIZE = 240;
 
-  Entity* create() {
-    entities_.emplace_back(std::make_unique<Entity>());
+  void push(float value) {
+    values_[next_] = value;
+    next_ = (next_ + 1) % SIZE;
+  }
 
-    auto* entity = entities_.back().get();
-    auto* controls = controls_.attach(entity);
-    auto* environment = environment_.attach(entity);
-    auto* physical = physical_.attach(entity);
-    auto* movement = movement_.attach(entity);
+  void draw(const char* label, const char* unit) const {
+    char latest[32];
+    std::snprintf(latest, sizeof(latest), "%.3g %s", values_[(next_ + SIZE - 1) % SIZE], unit);
+    ImGui::PlotLines(label, values_.data(), SIZE, next_, latest, 0.0f, FLT_MAX, ImVec2{0, 40});
+  }
 
-    movement->environment = environment;
-    movement->physical = physical;
-    movement->controls = controls;
-    physical->movement = movement;
+ private:
+  std::array<float, SIZE> values_{};
+  int next_ = 0;
+};
 
-    return entity;
+// Plots how the viewer and the simulation are doing, toggled with F1. The simulation thread only
+// counts its steps and samples them while the overlay is shown, so a hidden overlay costs it one
+// relaxed load per step.
+class PerfOverlay final {
+ public:
+  bool shown() const { return shown_.load(std::memory_order_relaxed); }
+  void toggle() { shown_.store(!shown(), std::memory_order_relaxed); }
+
+  // Simulation thread.
+  void sample(const Simulation& simulation) {
+    auto& sample = samples_.write_buffer();
+    sample.step = simulation.step_stats();
+    sample.memory = {};
+    for (auto&& [name, usage] : simulation.memory_usage()) {
+      sample.memory += usage;
+    }
+    samples_.publish();
   }
 
-  void operator()(TimePoint time, Duration step) {
-    static auto do_substep =
-      [](auto& system, TimePoint time, Duration step, framework::EventQueue* events) {
-        Duration substep = step * SUB_STEP_FACTOR;
-        for (TimePoint stop = time + step; time < stop; time += substep) {
-          system(time, substep, events);
-        }
-      };
-
-    events.process_until(time);
-    do_substep(environment_, time, step, &events);
-    do_substep(physical_, time, step, &events);
-    do_substep(controls_, time, step, &events);
-    do_substep(movement_, time, step, &events);
-  }
+  // Render thread, once per frame.
+  void draw(std::chrono::steady_clock::duration frame_time) {
+    frame_time_.push(to_milliseconds(frame_time));
+    if (!shown()) {
+      return;
+    }
 
-  framework::EventQueue events;
+    if (samples_.acquire()) {
+      const auto& sample = samples_.read_buffer();
+      step_time_.push(to_milliseconds(sample.step.step_time));
+      for (std::size_t i = 0; i < StepStats::SYSTEM_COUNT; ++i) {
+        system_times_[i].push(to_milliseconds(sample.step.system_times[i]));
+      }
+      events_processed_.push(sample.step.events_processed);
+      events_pending_.push(sample.step.events_pending);
+      memory_in_use_.push(sample.memory.in_use / 1024.0f);
+      memory_ = sample.memory;
+      entity_count_ = sample.step.entity_count;
+    }
+
+    bool shown = true;
+    ImGui::SetNextWindowBgAlpha(0.7f);
+    ImGui::Begin("Performance", &shown, ImGuiWindowFlags_AlwaysAutoResize);
+    frame_time_.draw("frame", "ms");
+    step_time_.draw("step", "ms");
+    for (std::size_t i = 0; i < StepStats::SYSTEM_COUNT; ++i) {
+      system_times_[i].draw(StepStats::SYSTEM_NAMES[i], "ms");
+    }
+    ImGui::Separator();
+    events_processed_.draw("events", "per step");
+    events_pending_.draw("pending", "events");
+    ImGui::Text("entities: %zu", entity_count_);
+    ImGui::Separator();
+    memory_in_use_.draw("memory", "KiB in use");
+    ImGui::Text("reserved: %zu KiB, %zu allocations in the last step",
+                memory_.reserved / 1024,
+                memory_.allocations);
+    ImGui::End();
+    if (!shown) {
+      toggle();
+    }
+  }
 
  private:
-  framework::ComponentSystem<component::Controls, framework::ComputeNone> controls_;
-  framework::ComponentSystem<component::Environment, framework::ComputeNone> environment_;
-  framework::ComponentSystem<component::Physical, DetectSphericalCollision> physical_;
-  framework::ComponentSystem<component::Movement, ComputeMovement> movement_;
-  std::vector<std::unique_ptr<Entity>> entities_;
+  template <typename DurationType>
+  static float to_milliseconds(DurationType duration) {
+    return std::chrono::duration<float, std::milli>{duration}.count();
+  }
+
+  std::atomic<bool> shown_ = false;
+  framework::TripleBuffer<PerfSample> samples_;
+
+  RollingPlot frame_time_;
+  RollingPlot step_time_;
+  std::array<RollingPlot, StepStats::SYSTEM_COUNT> system_times_;
+  RollingPlot events_processed_;
+  RollingPlot events_pending_;
+  RollingPlot memory_in_use_;
+  MemoryUsage memory_;
+  std::size_t entity_count_ = 0;
 };
 
 int main(int, char**) {
@@ -187,9 +259,9 @@ int main(int, char**) {
   ImGui_ImplSDL2_InitForSDLRenderer(window, renderer);
   ImGui_ImplSDLRenderer_Init(renderer);
   ImVec4 clear_color = ImVec4(0.35f, 0.45f, 0.50f, 1.00f);
+  BodyRenderer body_renderer{renderer};
 
   // Simulator
-  TimePoint curr_time;
   Simulation simulation;
 
   auto* ball_a = simulation.create();
@@ -205,61 +277,69 @@ int main(int, char**) {
   ball_b->component<component::Physical>()->radius = 10.0;
   ball_b->component<component::Movement>()->position = {360.0, 600.0, 0.0};
 
-  auto* ball_a_movement = ball_a->component<component::Movement>();
   auto* ball_a_physical = ball_a->component<component::Physical>();
-  auto* ball_b_movement = ball_b->component<component::Movement>();
   auto* ball_b_physical = ball_b->component<component::Physical>();
 
-  bool done = false;
+  std::atomic<bool> done = false;
   simulation.events.subscribe<Collision>([&](TimePoint time, const Collision& event) {
     ASSERT((event.a == ball_a_physical || event.a == ball_b_physical) &&
            (event.b == ball_a_physical || event.b == ball_b_physical));
     done = true;
   });
 
+  // The simulation steps on its own thread at its own rate, and publishes a
+  // snapshot of every body after each step. The renderer picks up whichever
+  // snapshot is newest when it starts a frame, so neither waits on the other.
+  framework::TripleBuffer<std::vector<BodySnapshot>> snapshots;
+  PerfOverlay overlay;
+  std::thread simulation_thread{[&] {
+    using Clock = std::chrono::steady_clock;
+    TimePoint curr_time;
+    auto deadline = Clock::now();
+    while (!done) {
+      const bool sampled = overlay.shown();
+      simulation.count_steps(sampled);
+      simulation(curr_time, Simulation::STEP_SIZE);
+      curr_time += Simulation::STEP_SIZE;
+
+      simulation.snapshot(&snapshots.write_buffer());
+      snapshots.publish();
+      if (sampled) {
+        overlay.sample(simulation);
+      }
+
+      // Fall behind rather than burst to catch up after a stall.
+      deadline = std::max(deadline + STEP_PERIOD, Clock::now());
+      std::this_thread::sleep_until(deadline);
+    }
+  }};
+
   // Main loop
+  auto frame_start = std::chrono::steady_clock::now();
   while (!done) {
+    auto frame_end = std::chrono::steady_clock::now();
+    auto frame_time = frame_end - frame_start;
+    frame_start = frame_end;
+
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
       ImGui_ImplSDL2_ProcessEvent(&event);
       if (event.type == SDL_QUIT) done = true;
+      if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F1 && !event.key.repeat)
+        overlay.toggle();
       if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE &&
           event.window.windowID == SDL_GetWindowID(window))
         done = true;
     }
 
-    // Start simulation
-    TimePoint slice_time{curr_time + Simulation::STEP_SIZE};
-    for (; curr_time < slice_time; curr_time += Simulation::STEP_SIZE) {
-      simulation(curr_time, Simulation::STEP_SIZE);
-    }
+    snapshots.acquire();
+    const auto& bodies = snapshots.read_buffer();
 
     // Start the Dear ImGui frame
     ImGui_ImplSDLRenderer_NewFrame();
     ImGui_ImplSDL2_NewFrame();
     ImGui::NewFrame();
-
-    const ImU32 red = ImColor(ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
-    const ImU32 blue = ImColor(ImVec4(0.0f, 0.0f, 1.0f, 1.0f));
-    const ImU32 sides = 12;
-
-    const ImGuiViewport* viewport = ImGui::GetMainViewport();
-    ImGui::SetNextWindowPos(viewport->WorkPos);
-    ImGui::SetNextWindowSize(viewport->WorkSize);
-    ImGui::Begin("Window",
-                 nullptr,
-                 ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_NoDecoration |
-                   ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoSavedSettings);
-    ImDrawList* draw_list = ImGui::GetWindowDrawList();
-    draw_list->AddCircleFilled(ImVec2(ball_a_movement->position[0], ball_a_movement->position[1]),
-                               ball_a_physical->radius,
-                               red,
-                               sides);
-    draw_list->AddCircleFilled(ImVec2(ball_b_movement->position[0], ball_b_movement->position[1]),
-                               ball_b_physical->radius,
-                               blue,
-                               sides);
-    ImGui::End();
+    overlay.draw(frame_time);
 
     // Rendering
     ImGui::Render();
@@ -269,11 +349,13 @@ int main(int, char**) {
                            (Uint8)(clear_color.z * 255),
                            (Uint8)(clear_color.w * 255));
     SDL_RenderClear(renderer);
+    body_renderer.draw(bodies);
     ImGui_ImplSDLRenderer_RenderDrawData(ImGui::GetDrawData());
     SDL_RenderPresent(renderer);
   }
 
   // Cleanup
+  simulation_thread.join();
   ImGui_ImplSDLRenderer_Shutdown();
   ImGui_ImplSDL2_Shutdown();
   ImGui::DestroyContext();
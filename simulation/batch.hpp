@@ -0,0 +1,161 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "base/core.hpp"
+#include "base/math.hpp"
+#include "base/time.hpp"
+#include "base/trace.hpp"
+#include "simulation/integrators.hpp"
+#include "simulation/simulation.hpp"
+
+namespace simon::simulation {
+
+// One body of one world in a batch: what its components hold in a `Simulation`.
+struct BatchBody final {
+  PaddedVec3 position;
+  PaddedVec3 velocity;
+  PaddedVec3 acceleration;  // Controlled.
+  PaddedVec3 wind;
+  Scalar radius = 0.0;
+  Scalar wind_resistance_factor = 1.0;
+};
+
+// Worlds of the same layout stepped together, e.g. for parameter sweeps over the same bodies.
+// Each value of a body is stored once per world, in a lane, so that the kernels advance every
+// world at once in vector registers: state is laid out [body][value][axis][world lane]. Steps as
+// `Simulation` does, body i of each world being the i-th entity created; where worlds diverge,
+// such as in which bodies collide, masks of lanes keep them apart.
+template <std::size_t LANE_COUNT>
+class WorldBatch final {
+ public:
+  using Lanes = Eigen::Array<Scalar, LANE_COUNT, 1>;   // A value in every world.
+  using Lanes3 = Eigen::Array<Scalar, LANE_COUNT, 3>;  // A vector in every world, by axis.
+  using LaneMask = Eigen::Array<bool, LANE_COUNT, 1>;  // Some of the worlds.
+
+  // Two bodies touching within a tick in some of the worlds. Published by a `Simulation` as a
+  // `Collision` each way round; reported here once.
+  struct Collision final {
+    std::size_t a = 0;
+    std::size_t b = 0;
+    LaneMask lanes;
+    TimePoint time;  // The tick's start.
+    Lanes contact;   // Seconds from `time` till they first touched, in each of `lanes`.
+  };
+
+  DECLARE_COPY_DELETE(WorldBatch);
+
+  explicit WorldBatch(std::size_t body_count) : bodies_(body_count) {}
+
+  static constexpr std::size_t lane_count() { return LANE_COUNT; }
+  std::size_t body_count() const { return bodies_.size(); }
+
+  void set_body(std::size_t lane, std::size_t body, const BatchBody& state) {
+    CHECK_PRECONDITION(lane < LANE_COUNT && body < bodies_.size());
+    BodyLanes& lanes = bodies_[body];
+    lanes.position.row(lane) = state.position.xyz().transpose().array();
+    lanes.velocity.row(lane) = state.velocity.xyz().transpose().array();
+    lanes.acceleration.row(lane) = state.acceleration.xyz().transpose().array();
+    lanes.wind.row(lane) = state.wind.xyz().transpose().array();
+    lanes.radius[lane] = state.radius;
+    lanes.wind_resistance_factor[lane] = state.wind_resistance_factor;
+  }
+
+  BatchBody body(std::size_t lane, std::size_t body) const {
+    CHECK_PRECONDITION(lane < LANE_COUNT && body < bodies_.size());
+    const BodyLanes& lanes = bodies_[body];
+    auto vector = [lane](const Lanes3& values) {
+      return PaddedVec3{values(lane, 0), values(lane, 1), values(lane, 2)};
+    };
+    return {.position = vector(lanes.position),
+            .velocity = vector(lanes.velocity),
+            .acceleration = vector(lanes.acceleration),
+            .wind = vector(lanes.wind),
+            .radius = lanes.radius[lane],
+            .wind_resistance_factor = lanes.wind_resistance_factor[lane]};
+  }
+
+  // The worlds of inactive lanes neither move nor collide, e.g. the lanes past the last world of
+  // a partial batch, or worlds retired early. Every lane starts active.
+  void set_active(std::size_t lane, bool active) { active_[lane] = active; }
+  const LaneMask& active() const { return active_; }
+
+  void operator()(TimePoint time, Duration step) {
+    TRACE_SPAN("batch", "step");
+    collisions_.clear();
+    auto detect = [this](TimePoint tick_time, Duration tick, auto) {
+      detect_collisions(tick_time, tick);
+    };
+    auto move = [this](TimePoint, Duration tick, auto) { this->move(tick); };
+    Simulation::PHYSICAL_RATE(detect, step_index_, time, step, nullptr);
+    Simulation::MOVEMENT_RATE(move, step_index_, time, step, nullptr);
+    step_index_++;
+  }
+
+  // Those found in the last step, by time and then by body.
+  const std::vector<Collision>& collisions() const { return collisions_; }
+
+ private:
+  struct BodyLanes final {
+    Lanes3 position = Lanes3::Zero();
+    Lanes3 velocity = Lanes3::Zero();
+    Lanes3 acceleration = Lanes3::Zero();
+    Lanes3 wind = Lanes3::Zero();
+    Lanes radius = Lanes::Zero();
+    Lanes wind_resistance_factor = Lanes::Ones();
+  };
+
+  // As `DetectSweptCollision` does, by `time_of_impact()` in every lane at once. Lanes whose
+  // bodies do not touch compute a meaningless time, which their mask discards.
+  void detect_collisions(TimePoint time, Duration tick) {
+    const Scalar duration = to_seconds<Scalar>(tick);
+    for (std::size_t a = 0; a < bodies_.size(); ++a) {
+      for (std::size_t b = a + 1; b < bodies_.size(); ++b) {
+        const Lanes3 distance = bodies_[b].position - bodies_[a].position;
+        const Lanes3 velocity = bodies_[b].velocity - bodies_[a].velocity;
+        const Lanes radius = bodies_[a].radius + bodies_[b].radius;
+        const Lanes gap = distance.square().rowwise().sum() - radius.square();
+        const Lanes closing = (distance * velocity).rowwise().sum();
+        const Lanes discriminant = closing.square() - velocity.square().rowwise().sum() * gap;
+        const LaneMask touching = gap <= Scalar{0};
+        const Lanes contact =
+          touching.select(Lanes::Zero(), gap / (discriminant.sqrt() - closing));
+        const LaneMask lanes =
+          active_ &&
+          (touching || (closing < Scalar{0} && discriminant >= Scalar{0} && contact <= duration));
+        if (lanes.any()) {
+          collisions_.push_back({.a = a,
+                                 .b = b,
+                                 .lanes = lanes,
+                                 .time = time,
+                                 .contact = lanes.select(contact, Lanes::Zero())});
+        }
+      }
+    }
+  }
+
+  // As `ComputeMovement` does.
+  void move(Duration tick) {
+    const Scalar dt = to_seconds<Scalar>(tick);
+    const auto active = active_.template replicate<1, 3>();
+    for (BodyLanes& body : bodies_) {
+      const Lanes3 acceleration =
+        body.acceleration + (body.wind - body.velocity).colwise() * body.wind_resistance_factor;
+      Lanes3 position = body.position;
+      Lanes3 velocity = body.velocity;
+      integrate_runge_kutta_2(&position, &velocity, acceleration, dt);
+      body.position = active.select(position, body.position);
+      body.velocity = active.select(velocity, body.velocity);
+    }
+  }
+
+  std::vector<BodyLanes> bodies_;
+  LaneMask active_ = LaneMask::Constant(true);
+  std::vector<Collision> collisions_;
+  std::size_t step_index_ = 0;
+};
+
+}  // namespace simon::simulation
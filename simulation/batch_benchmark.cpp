@@ -0,0 +1,76 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+// Compares stepping worlds of the same layout one at a time with stepping
+// them together, a world per lane.
+// Run with `bazel run //simulation:batch_benchmark`.
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/testing.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "simulation/batch.hpp"
+#include "simulation/simulation.hpp"
+
+namespace simon::simulation {
+namespace {
+
+constexpr std::size_t LANES = 4;
+constexpr std::size_t WORLD_COUNT = 4 * LANES;
+constexpr std::size_t BODY_COUNT = 64;
+
+// The same bodies in every world, with their speeds perturbed.
+std::vector<BatchBody> bodies_of(std::size_t world) {
+  std::mt19937 generate{42};
+  std::uniform_real_distribution<Scalar> uniform{-100, 100};
+  const Scalar perturbation = 1.0 + 0.01 * world;
+  std::vector<BatchBody> bodies(BODY_COUNT);
+  for (auto& body : bodies) {
+    body.position = {uniform(generate), uniform(generate), 0};
+    body.velocity = PaddedVec3{uniform(generate), uniform(generate), 0} * perturbation;
+    body.radius = 1.0;
+  }
+  return bodies;
+}
+
+}  // namespace
+
+TEST_CASE("BatchedWorlds") {
+  std::vector<std::unique_ptr<Simulation>> worlds;
+  std::vector<std::unique_ptr<WorldBatch<LANES>>> batches;
+  for (std::size_t world = 0; world < WORLD_COUNT; ++world) {
+    auto bodies = bodies_of(world);
+    auto& alone = worlds.emplace_back(std::make_unique<Simulation>(world));
+    if (world % LANES == 0) {
+      batches.push_back(std::make_unique<WorldBatch<LANES>>(BODY_COUNT));
+    }
+    for (std::size_t body = 0; body < BODY_COUNT; ++body) {
+      auto* entity = alone->create();
+      entity->component<component::Movement>()->position = bodies[body].position;
+      entity->component<component::Movement>()->velocity = bodies[body].velocity;
+      entity->component<component::Physical>()->radius = bodies[body].radius;
+      batches.back()->set_body(world % LANES, body, bodies[body]);
+    }
+  }
+
+  TimePoint alone_time;
+  BENCHMARK("Alone") {
+    for (auto& world : worlds) {
+      (*world)(alone_time, Simulation::STEP_SIZE);
+    }
+    alone_time += Simulation::STEP_SIZE;
+    return worlds.front()->step_stats().events_processed;
+  };
+
+  TimePoint batch_time;
+  BENCHMARK("Batched") {
+    for (auto& batch : batches) {
+      (*batch)(batch_time, Simulation::STEP_SIZE);
+    }
+    batch_time += Simulation::STEP_SIZE;
+    return batches.front()->collisions().size();
+  };
+}
+
+}  // namespace simon::simulation
@@ -0,0 +1,129 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "simulation/batch.hpp"
+
+#include "base/testing.hpp"
+
+namespace simon::simulation {
+namespace {
+constexpr std::size_t LANES = 4;
+
+// Two bodies heading for each other, faster and in a stronger wind the later the world.
+BatchBody body_of(std::size_t lane, std::size_t body) {
+  const Scalar speed = Scalar(1) + Scalar(lane);
+  return {.position = {body == 0 ? Scalar(0) : Scalar(10), 0, 0},
+          .velocity = {body == 0 ? speed : -speed, 0, 0},
+          .acceleration = {0, body == 0 ? Scalar(1) : Scalar(-1), 0},
+          .wind = {0, Scalar(0.5) * Scalar(lane), 0},
+          .radius = 1.0,
+          .wind_resistance_factor = 0.1};
+}
+
+void set_up(Simulation* world, std::size_t lane) {
+  for (std::size_t body = 0; body < 2; ++body) {
+    const BatchBody state = body_of(lane, body);
+    auto* entity = world->create();
+    entity->component<component::Movement>()->position = state.position;
+    entity->component<component::Movement>()->velocity = state.velocity;
+    entity->component<component::Controls>()->acceleration = state.acceleration;
+    entity->component<component::Environment>()->wind = state.wind;
+    entity->component<component::Physical>()->radius = state.radius;
+    entity->component<component::Physical>()->wind_resistance_factor =
+      state.wind_resistance_factor;
+  }
+}
+
+void set_up(WorldBatch<LANES>* batch) {
+  for (std::size_t lane = 0; lane < LANES; ++lane) {
+    for (std::size_t body = 0; body < 2; ++body) {
+      batch->set_body(lane, body, body_of(lane, body));
+    }
+  }
+}
+}  // namespace
+
+TEST_CASE("WorldBatch") {
+  WorldBatch<LANES> batch{2};
+  set_up(&batch);
+
+  SECTION("ShouldKeepBodiesOfEachLane") {
+    const BatchBody body = batch.body(2, 1);
+
+    CHECK(body.position == body_of(2, 1).position);
+    CHECK(body.velocity == body_of(2, 1).velocity);
+    CHECK(body.wind == body_of(2, 1).wind);
+    CHECK(body.radius == Scalar{1.0});
+  }
+
+  SECTION("ShouldStepEachLaneAsItsOwnWorld") {
+    TimePoint time;
+    for (int step = 0; step < 15; ++step, time += Simulation::STEP_SIZE) {
+      batch(time, Simulation::STEP_SIZE);
+    }
+    const TimePoint last_step = time - Simulation::STEP_SIZE;
+    REQUIRE(!batch.collisions().empty());
+
+    for (std::size_t lane = 0; lane < LANES; ++lane) {
+      Simulation world;
+      set_up(&world, lane);
+      std::size_t collisions = 0;
+      TimePoint contact_time;
+      world.events.subscribe<Collision>([&](TimePoint, const Collision& collision) {
+        collisions++;
+        contact_time = collision.time;
+      });
+      for (TimePoint world_time; world_time < last_step; world_time += Simulation::STEP_SIZE) {
+        world(world_time, Simulation::STEP_SIZE);
+      }
+      world.events.process_until(last_step);
+      collisions = 0;
+      world(last_step, Simulation::STEP_SIZE);
+      world.events.process_until(time);
+
+      std::vector<BodySnapshot> bodies;
+      world.snapshot(&bodies);
+      for (std::size_t body = 0; body < 2; ++body) {
+        CHECK(batch.body(lane, body).position.head<2>().isApprox(bodies[body].position));
+      }
+      // Published each way round by the world, once by the batch.
+      std::size_t batch_collisions = 0;
+      for (auto&& collision : batch.collisions()) {
+        if (collision.lanes[lane]) {
+          batch_collisions += 2;
+          CHECK(collision.time + from_seconds(collision.contact[lane]) == contact_time);
+        }
+      }
+      CHECK(batch_collisions == collisions);
+    }
+  }
+
+  SECTION("ShouldMaskCollisionsByLane") {
+    TimePoint time;
+    for (int step = 0; step < 20 && batch.collisions().empty(); ++step) {
+      batch(time, Simulation::STEP_SIZE);
+      time += Simulation::STEP_SIZE;
+    }
+
+    // Closing at 2, 4, 6 and 8 per second, the fastest world meets first.
+    REQUIRE(!batch.collisions().empty());
+    for (auto&& collision : batch.collisions()) {
+      CHECK(collision.a == 0);
+      CHECK(collision.b == 1);
+      CHECK(!collision.lanes[0]);
+      CHECK(!collision.lanes[1]);
+      CHECK(collision.lanes[3]);
+    }
+  }
+
+  SECTION("ShouldNotStepInactiveLanes") {
+    batch.set_active(1, false);
+
+    batch(TimePoint{}, Simulation::STEP_SIZE);
+
+    CHECK(batch.body(1, 0).position == body_of(1, 0).position);
+    CHECK(batch.body(1, 0).velocity == body_of(1, 0).velocity);
+    CHECK(batch.body(0, 0).position != body_of(0, 0).position);
+  }
+}
+
+}  // namespace simon::simulation
@@ -0,0 +1,125 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <vector>
+
+#include "base/math.hpp"
+#include "base/time.hpp"
+#include "component/movement.hpp"
+#include "component/physical.hpp"
+#include "framework/component_system.hpp"
+#include "framework/event_queue.hpp"
+
+namespace simon::simulation {
+
+struct Collision final {
+  component::Physical* a = nullptr;
+  component::Physical* b = nullptr;
+  TimePoint time;  // When they first touched, if known; handlers are called later.
+};
+
+template <typename VectorType, typename ScalarType>
+bool has_collision(const VectorType& position_a,
+                   ScalarType radius_a,
+                   const VectorType& position_b,
+                   ScalarType radius_b) {
+  auto distance = static_cast<VectorType>(position_a - position_b).norm();
+  return distance <= (radius_a + radius_b);
+}
+
+inline bool has_collision(component::Physical* a, component::Physical* b) {
+  return has_collision(a->movement->position, a->radius, b->movement->position, b->radius);
+}
+
+// How long until two spheres moving in straight lines at constant velocities first touch: zero if
+// they already do, or none if they do not within `duration`. Solves |d + v t| = r for their
+// relative position d and velocity v, and the sum of their radii r.
+template <typename VectorType, typename ScalarType>
+std::optional<ScalarType> time_of_impact(const VectorType& position_a,
+                                         const VectorType& velocity_a,
+                                         ScalarType radius_a,
+                                         const VectorType& position_b,
+                                         const VectorType& velocity_b,
+                                         ScalarType radius_b,
+                                         ScalarType duration) {
+  const VectorType distance = position_b - position_a;
+  const VectorType velocity = velocity_b - velocity_a;
+  const ScalarType radius = radius_a + radius_b;
+  const ScalarType gap = distance.squaredNorm() - radius * radius;
+  if (gap <= ScalarType{0}) {
+    return ScalarType{0};
+  }
+  const ScalarType closing = distance.dot(velocity);
+  if (closing >= ScalarType{0}) {
+    return std::nullopt;
+  }
+  const ScalarType discriminant = closing * closing - velocity.squaredNorm() * gap;
+  if (discriminant < ScalarType{0}) {
+    return std::nullopt;  // They pass each other by.
+  }
+  // The earlier root, written so that it does not cancel when they barely close.
+  const ScalarType time = gap / (std::sqrt(discriminant) - closing);
+  if (time > duration) {
+    return std::nullopt;
+  }
+  return time;
+}
+
+inline std::optional<Scalar> time_of_impact(component::Physical* a,
+                                            component::Physical* b,
+                                            Scalar duration) {
+  return time_of_impact(a->movement->position,
+                        a->movement->velocity,
+                        a->radius,
+                        b->movement->position,
+                        b->movement->velocity,
+                        b->radius,
+                        duration);
+}
+
+struct DetectSphericalCollision : public framework::ComputeBase<component::Physical> {
+  void prepare(component::Physical* current) { others.push_back(current); }
+  void operator()(component::Physical* current,
+                  TimePoint time,
+                  Duration step,
+                  framework::EventQueue* events) {
+    for (auto* other : others) {
+      if (current != other && has_collision(current, other)) {
+        events->publish<Collision>(time, current, other);
+      }
+    }
+  }
+  void resolve(component::Physical* current) { others.clear(); }
+  std::vector<component::Physical*> others;
+};
+
+// Publishes when, within each tick, bodies first touch, taking them to move in straight lines at
+// their velocities as of the tick's start. Unlike `DetectSphericalCollision`, which only tests
+// overlap at the tick's start, fast bodies cannot pass through each other between ticks, so one
+// tick may span a whole step. Each collision is published at its time of impact.
+struct DetectSweptCollision : public framework::ComputeBase<component::Physical> {
+  void prepare(component::Physical* current) { others.push_back(current); }
+  void operator()(component::Physical* current,
+                  TimePoint time,
+                  Duration step,
+                  framework::EventQueue* events) {
+    for (auto* other : others) {
+      if (current == other) {
+        continue;
+      }
+      if (auto contact = time_of_impact(current, other, to_seconds<Scalar>(step))) {
+        // Rounded to the clock, but never past the tick.
+        const TimePoint contact_time = time + std::min(from_seconds(*contact), step);
+        events->publish<Collision>(contact_time, current, other, contact_time);
+      }
+    }
+  }
+  void resolve(component::Physical* current) { others.clear(); }
+  std::vector<component::Physical*> others;
+};
+
+}  // namespace simon::simulation
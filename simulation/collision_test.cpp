@@ -0,0 +1,156 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "simulation/collision.hpp"
+
+#include <cmath>
+
+#include "base/testing.hpp"
+
+namespace simon::simulation {
+
+TEST_CASE("HasCollision") {
+  SECTION("ShouldCollideWhenTouching") {
+    CHECK(has_collision(Vec3{0.0, 0.0, 0.0}, Scalar{1.0}, Vec3{2.0, 0.0, 0.0}, Scalar{1.0}));
+  }
+
+  SECTION("ShouldNotCollideWhenApart") {
+    CHECK(!has_collision(Vec3{0.0, 0.0, 0.0}, Scalar{1.0}, Vec3{2.5, 0.0, 0.0}, Scalar{1.0}));
+  }
+
+  SECTION("ShouldAgreeInEitherPrecision") {
+    CHECK(has_collision(BasicVector<float, 3>{0.f, 0.f, 0.f},
+                        1.f,
+                        BasicVector<float, 3>{0.f, 1.5f, 0.f},
+                        1.f));
+    CHECK(has_collision(BasicVector<double, 3>{0.0, 0.0, 0.0},
+                        1.0,
+                        BasicVector<double, 3>{0.0, 1.5, 0.0},
+                        1.0));
+  }
+}
+
+TEST_CASE("TimeOfImpact") {
+  Vec3 position_a{0.0, 0.0, 0.0};
+  Vec3 velocity_a{10.0, 0.0, 0.0};
+  Vec3 position_b{10.0, 0.0, 0.0};
+  Vec3 velocity_b{0.0, 0.0, 0.0};
+  Scalar radius = 1.0;
+
+  auto time_of_impact_within = [&](Scalar duration) {
+    return time_of_impact(
+      position_a, velocity_a, radius, position_b, velocity_b, radius, duration);
+  };
+
+  SECTION("ShouldFindWhenClosingSpheresTouch") {
+    auto time = time_of_impact_within(1.0);
+
+    REQUIRE(time);
+    CHECK(std::abs(*time - Scalar{0.8}) < 1e-12);
+  }
+
+  SECTION("ShouldFindContactOfSpheresPassingThroughWithinDuration") {
+    velocity_a = {100.0, 0.0, 0.0};
+    REQUIRE(!has_collision(Vec3{position_a + velocity_a * 0.2}, radius, position_b, radius));
+
+    auto time = time_of_impact_within(0.2);
+
+    REQUIRE(time);
+    CHECK(std::abs(*time - Scalar{0.08}) < 1e-12);
+  }
+
+  SECTION("ShouldBeZeroWhenAlreadyTouching") {
+    position_b = {1.5, 0.0, 0.0};
+
+    CHECK(time_of_impact_within(1.0) == Scalar{0});
+  }
+
+  SECTION("ShouldNotFindBeyondDuration") {
+    CHECK(!time_of_impact_within(0.5));
+  }
+
+  SECTION("ShouldNotFindWhenMovingApart") {
+    velocity_a = {-10.0, 0.0, 0.0};
+
+    CHECK(!time_of_impact_within(10.0));
+  }
+
+  SECTION("ShouldNotFindWhenPassingBy") {
+    position_b = {10.0, 2.5, 0.0};
+
+    CHECK(!time_of_impact_within(10.0));
+  }
+}
+
+TEST_CASE("DetectSphericalCollision") {
+  framework::EventQueue events;
+  framework::ComponentSystem<component::Physical, DetectSphericalCollision> physical;
+  framework::Entity entity_a, entity_b;
+  component::Movement movement_a, movement_b;
+  auto* a = physical.attach(&entity_a);
+  auto* b = physical.attach(&entity_b);
+  a->movement = &movement_a;
+  b->movement = &movement_b;
+  a->radius = b->radius = 1.0;
+
+  std::size_t collisions = 0;
+  events.subscribe<Collision>([&collisions](TimePoint, const Collision&) { collisions++; });
+
+  SECTION("ShouldPublishCollisionForEachOverlappingPair") {
+    movement_a.position = {0.0, 0.0, 0.0};
+    movement_b.position = {1.0, 0.0, 0.0};
+
+    physical(TimePoint{}, from_seconds(0.1), &events);
+    events.process_until(TimePoint{});
+
+    CHECK(collisions == 2);
+  }
+
+  SECTION("ShouldNotPublishWithoutOverlap") {
+    movement_a.position = {0.0, 0.0, 0.0};
+    movement_b.position = {5.0, 0.0, 0.0};
+
+    physical(TimePoint{}, from_seconds(0.1), &events);
+    events.process_until(TimePoint{});
+
+    CHECK(collisions == 0);
+  }
+}
+
+TEST_CASE("DetectSweptCollision") {
+  framework::EventQueue events;
+  framework::ComponentSystem<component::Physical, DetectSweptCollision> physical;
+  framework::Entity entity_a, entity_b;
+  component::Movement movement_a, movement_b;
+  auto* a = physical.attach(&entity_a);
+  auto* b = physical.attach(&entity_b);
+  a->movement = &movement_a;
+  b->movement = &movement_b;
+  a->radius = b->radius = 1.0;
+  movement_b.position = {10.0, 0.0, 0.0};
+
+  std::vector<Collision> collisions;
+  events.subscribe<Collision>(
+    [&collisions](TimePoint, const Collision& collision) { collisions.push_back(collision); });
+
+  SECTION("ShouldPublishTimeOfImpactWithinTick") {
+    movement_a.velocity = {100.0, 0.0, 0.0};
+
+    physical(TimePoint{}, from_seconds(0.2), &events);
+    events.process_until(TimePoint{from_seconds(0.2)});
+
+    REQUIRE(collisions.size() == 2);
+    CHECK(collisions[0].time == TimePoint{from_seconds(0.08)});
+    CHECK(collisions[1].time == collisions[0].time);
+  }
+
+  SECTION("ShouldNotPublishWithoutContactWithinTick") {
+    movement_a.velocity = {10.0, 0.0, 0.0};
+
+    physical(TimePoint{}, from_seconds(0.2), &events);
+    events.process_until(TimePoint{from_seconds(0.2)});
+
+    CHECK(collisions.empty());
+  }
+}
+
+}  // namespace simon::simulation
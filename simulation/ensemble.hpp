@@ -0,0 +1,115 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "base/time.hpp"
+#include "base/worker_pool.hpp"
+#include "simulation/simulation.hpp"
+
+namespace simon::simulation {
+
+// Many independent worlds stepped at once on a worker pool, e.g. for Monte Carlo sweeps over
+// perturbed initial conditions. Worlds share no mutable state while stepping: each names its
+// entities from its own seed, and owns its events, components, stats and memory accounts. Type
+// identities are constants, and type records are only written once, on first use. Status domains
+// stay process-wide, but worlds raise no statuses, so none of their incidents are shared; code
+// that raises from inside a world should use `thread_local_enum_status_domain`. So worlds scale
+// with the pool's workers, which steal whole worlds from each other when some take longer.
+class Ensemble final {
+ public:
+  // Makes `world_count` worlds, the i-th seeded with `seed + i` and populated by
+  // `setup(i, &world)`. Worlds are made on the pool's workers, so that each is allocated by the
+  // thread likely to step it.
+  template <typename SetupType>
+  Ensemble(WorkerPool* pool, std::size_t world_count, SetupType&& setup, std::uint64_t seed = 0)
+    : pool_{pool}, worlds_(world_count) {
+    pool_->for_each_index(world_count, [&](std::size_t index) {
+      worlds_[index] = std::make_unique<World>(seed + index);
+      setup(index, &worlds_[index]->simulation);
+    });
+  }
+
+  Ensemble(const Ensemble&) = delete;
+  Ensemble& operator=(const Ensemble&) = delete;
+
+  std::size_t size() const { return worlds_.size(); }
+  const Simulation& world(std::size_t index) const { return worlds_[index]->simulation; }
+  TimePoint time(std::size_t index) const { return worlds_[index]->time; }
+
+  // Steps every world on by `step_count` steps.
+  void run(std::size_t step_count) {
+    pool_->for_each_index(size(), [this, step_count](std::size_t index) {
+      World& world = *worlds_[index];
+      for (std::size_t step = 0; step < step_count; ++step) {
+        world.simulation(world.time, Simulation::STEP_SIZE);
+        world.time += Simulation::STEP_SIZE;
+      }
+    });
+  }
+
+  // Returns `measure(i, world)` of every world, in world order.
+  template <typename MeasureType>
+  auto measure(MeasureType&& measure) const {
+    using ResultType = std::invoke_result_t<MeasureType&, std::size_t, const Simulation&>;
+    static_assert(!std::is_same_v<ResultType, bool>,
+                  "Unsupported: bits of a std::vector<bool> cannot be written concurrently");
+
+    std::vector<ResultType> results(size());
+    pool_->for_each_index(size(), [&](std::size_t index) {
+      results[index] = measure(index, worlds_[index]->simulation);
+    });
+    return results;
+  }
+
+ private:
+  struct World final {
+    explicit World(std::uint64_t seed) : simulation{seed} {}
+
+    Simulation simulation;
+    TimePoint time;
+  };
+
+  WorkerPool* pool_;
+  std::vector<std::unique_ptr<World>> worlds_;  // Allocated apart, so that worlds share no lines.
+};
+
+struct EnsembleSummary final {
+  std::size_t count = 0;
+  double mean = 0.0;
+  double standard_deviation = 0.0;  // Of the sample.
+  double min = std::numeric_limits<double>::infinity();
+  double max = -std::numeric_limits<double>::infinity();
+};
+
+// Summarizes `project(result)` over the results of every world, in one pass.
+template <typename ResultType, typename ProjectionType = std::identity>
+EnsembleSummary summarize(const std::vector<ResultType>& results, ProjectionType project = {}) {
+  // Welford's algorithm, which does not lose precision to cancellation.
+  EnsembleSummary summary;
+  double squares = 0.0;
+  for (auto&& result : results) {
+    const double value = std::invoke(project, result);
+    summary.count++;
+    const double delta = value - summary.mean;
+    summary.mean += delta / summary.count;
+    squares += delta * (value - summary.mean);
+    summary.min = std::min(summary.min, value);
+    summary.max = std::max(summary.max, value);
+  }
+  if (summary.count > 1) {
+    summary.standard_deviation = std::sqrt(squares / (summary.count - 1));
+  }
+  return summary;
+}
+
+}  // namespace simon::simulation
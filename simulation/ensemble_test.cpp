@@ -0,0 +1,95 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "simulation/ensemble.hpp"
+
+#include <cmath>
+
+#include "base/testing.hpp"
+
+namespace simon::simulation {
+namespace {
+// One body per world, moving faster the later its world.
+void setup_world(std::size_t index, Simulation* world) {
+  auto* body = world->create();
+  body->component<component::Physical>()->radius = 1.0;
+  body->component<component::Movement>()->velocity = {Scalar(1) + Scalar(index), 0, 0};
+}
+
+double position_of(std::size_t, const Simulation& world) {
+  std::vector<BodySnapshot> bodies;
+  world.snapshot(&bodies);
+  return bodies[0].position[0];
+}
+}  // namespace
+
+TEST_CASE("Ensemble") {
+  WorkerPool pool{4};
+
+  SECTION("ShouldStepEveryWorldAsIfAlone") {
+    Ensemble ensemble{&pool, 16, setup_world};
+    ensemble.run(10);
+
+    auto positions = ensemble.measure(position_of);
+
+    REQUIRE(positions.size() == 16);
+    for (std::size_t index = 0; index < positions.size(); ++index) {
+      Simulation alone;
+      setup_world(index, &alone);
+      TimePoint time;
+      for (int step = 0; step < 10; ++step, time += Simulation::STEP_SIZE) {
+        alone(time, Simulation::STEP_SIZE);
+      }
+      CHECK(positions[index] == position_of(index, alone));
+      CHECK(ensemble.time(index) == time);
+    }
+    CHECK(positions[15] > positions[0]);
+  }
+
+  SECTION("ShouldSeedEachWorldApart") {
+    std::vector<std::uint64_t> names(3);
+    auto name_body = [&names](std::size_t index, Simulation* world) {
+      names[index] = world->create()->entity_name().value();
+    };
+    Ensemble ensemble{&pool, names.size(), name_body, 100};
+    Simulation expected{101};
+
+    CHECK(names[1] == expected.create()->entity_name().value());
+    CHECK(names[0] != names[1]);
+  }
+}
+
+TEST_CASE("EnsembleSummary") {
+  SECTION("ShouldSummarizeResults") {
+    std::vector<double> results{2, 4, 4, 4, 5, 5, 7, 9};
+
+    auto summary = summarize(results);
+
+    CHECK(summary.count == 8);
+    CHECK(summary.mean == 5.0);
+    CHECK(std::abs(summary.standard_deviation - std::sqrt(32.0 / 7.0)) < 1e-12);
+    CHECK(summary.min == 2.0);
+    CHECK(summary.max == 9.0);
+  }
+
+  SECTION("ShouldSummarizeProjectedResults") {
+    struct Result {
+      double value;
+    };
+    std::vector<Result> results{{1.0}, {3.0}};
+
+    auto summary = summarize(results, &Result::value);
+
+    CHECK(summary.mean == 2.0);
+    CHECK(summary.min == 1.0);
+    CHECK(summary.max == 3.0);
+  }
+
+  SECTION("ShouldSummarizeNoResults") {
+    auto summary = summarize(std::vector<double>{});
+
+    CHECK(summary.count == 0);
+    CHECK(summary.standard_deviation == 0.0);
+  }
+}
+
+}  // namespace simon::simulation
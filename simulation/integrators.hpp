@@ -0,0 +1,100 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include "base/math.hpp"
+#include "base/time.hpp"
+#include "component/controls.hpp"
+#include "component/environment.hpp"
+#include "component/movement.hpp"
+#include "component/physical.hpp"
+#include "framework/component_system.hpp"
+#include "framework/event_queue.hpp"
+
+namespace simon::simulation {
+
+// Each integrator advances a position and velocity by `dt` under a constant
+// acceleration. They are templated on the vector and scalar types so the same
+// kernels run in either precision, whatever the build's `Scalar` is.
+
+template <typename VectorType, typename ScalarType>
+void integrate_forward_euler(VectorType* position,
+                             VectorType* velocity,
+                             const VectorType& acceleration,
+                             ScalarType dt) {
+  const VectorType prev_velocity = *velocity;
+  *velocity = prev_velocity + acceleration * dt;
+  *position = *position + prev_velocity * dt;
+}
+
+template <typename VectorType, typename ScalarType>
+void integrate_trapezoid(VectorType* position,
+                         VectorType* velocity,
+                         const VectorType& acceleration,
+                         ScalarType dt) {
+  const VectorType prev_velocity = *velocity;
+  *velocity = prev_velocity + acceleration * dt;
+  *position = *position + (prev_velocity + *velocity) * dt * ScalarType{0.5};
+}
+
+template <typename VectorType, typename ScalarType>
+void integrate_runge_kutta_2(VectorType* position,
+                             VectorType* velocity,
+                             const VectorType& acceleration,
+                             ScalarType dt) {
+  // k1.velocity = prev.velocity + acceleration * step;
+  // mid.velocity = prev.velocity + k1.velocity * step * 0.5;
+  // k2.velocity = mid.velocity + acceleration * step;
+
+  const VectorType prev_velocity = *velocity;
+  *velocity = prev_velocity + acceleration * dt;
+  *position = *position +
+              ((prev_velocity + (prev_velocity + acceleration * dt) * dt * ScalarType{0.5}) +
+               acceleration * dt) *
+                dt;
+}
+
+inline PaddedVec3 compute_acceleration(component::Movement* m) {
+  return m->controls->acceleration +
+         (m->physical->wind_resistance_factor * (m->environment->wind - m->velocity));
+}
+
+struct ForwardEulerMovement : public framework::ComputeBase<component::Movement> {
+  void operator()(component::Movement* movement,
+                  TimePoint time,
+                  Duration step,
+                  framework::EventQueue* events) {
+    integrate_forward_euler(&movement->position,
+                            &movement->velocity,
+                            compute_acceleration(movement),
+                            to_seconds<Scalar>(step));
+  }
+};
+
+struct TrapezoidMovement : public framework::ComputeBase<component::Movement> {
+  void operator()(component::Movement* movement,
+                  TimePoint time,
+                  Duration step,
+                  framework::EventQueue* events) {
+    integrate_trapezoid(&movement->position,
+                        &movement->velocity,
+                        compute_acceleration(movement),
+                        to_seconds<Scalar>(step));
+  }
+};
+
+struct RungeKutta2Movement : public framework::ComputeBase<component::Movement> {
+  void operator()(component::Movement* movement,
+                  TimePoint time,
+                  Duration step,
+                  framework::EventQueue* events) {
+    integrate_runge_kutta_2(&movement->position,
+                            &movement->velocity,
+                            compute_acceleration(movement),
+                            to_seconds<Scalar>(step));
+  }
+};
+
+struct ComputeMovement : public RungeKutta2Movement {};
+
+}  // namespace simon::simulation
@@ -0,0 +1,63 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "simulation/integrators.hpp"
+
+#include "base/testing.hpp"
+
+namespace simon::simulation {
+
+TEST_CASE("Integrators") {
+  Vec3 position{0.0, 0.0, 0.0};
+  Vec3 velocity{1.0, 0.0, 0.0};
+  Vec3 acceleration{0.0, 2.0, 0.0};
+  Scalar dt = 0.5;
+
+  SECTION("ForwardEulerShouldMoveByPreviousVelocity") {
+    integrate_forward_euler(&position, &velocity, acceleration, dt);
+
+    CHECK(position.isApprox(Vec3{0.5, 0.0, 0.0}));
+    CHECK(velocity.isApprox(Vec3{1.0, 1.0, 0.0}));
+  }
+
+  SECTION("TrapezoidShouldMoveByMeanVelocity") {
+    integrate_trapezoid(&position, &velocity, acceleration, dt);
+
+    CHECK(position.isApprox(Vec3{0.5, 0.25, 0.0}));
+    CHECK(velocity.isApprox(Vec3{1.0, 1.0, 0.0}));
+  }
+
+  SECTION("RungeKutta2ShouldUpdateVelocityByAcceleration") {
+    integrate_runge_kutta_2(&position, &velocity, acceleration, dt);
+
+    CHECK(velocity.isApprox(Vec3{1.0, 1.0, 0.0}));
+  }
+
+  SECTION("ShouldAgreeWhenPadded") {
+    PaddedVec3 padded_position{position};
+    PaddedVec3 padded_velocity{velocity};
+
+    integrate_runge_kutta_2(&position, &velocity, acceleration, dt);
+    integrate_runge_kutta_2(&padded_position, &padded_velocity, PaddedVec3{acceleration}, dt);
+
+    CHECK(padded_position.xyz().isApprox(position));
+    CHECK(padded_velocity.xyz().isApprox(velocity));
+    CHECK(padded_position.w() == Scalar{0});
+  }
+
+  SECTION("ShouldAgreeInEitherPrecision") {
+    BasicVector<float, 3> position_f = position.cast<float>();
+    BasicVector<float, 3> velocity_f = velocity.cast<float>();
+    BasicVector<double, 3> position_d = position.cast<double>();
+    BasicVector<double, 3> velocity_d = velocity.cast<double>();
+
+    for (int i = 0; i < 100; ++i) {
+      integrate_runge_kutta_2(&position_f, &velocity_f, acceleration.cast<float>().eval(), 0.01f);
+      integrate_runge_kutta_2(&position_d, &velocity_d, acceleration.cast<double>().eval(), 0.01);
+    }
+
+    CHECK(position_f.cast<double>().isApprox(position_d, 1e-5));
+    CHECK(velocity_f.cast<double>().isApprox(velocity_d, 1e-5));
+  }
+}
+
+}  // namespace simon::simulation
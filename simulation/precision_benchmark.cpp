@@ -0,0 +1,100 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+// Compares the movement and collision kernels in single and double precision,
+// unpadded and padded to four lanes, over the same bodies.
+// Run with `bazel run //simulation:precision_benchmark`.
+
+#include <random>
+#include <vector>
+
+#include "base/testing.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "simulation/collision.hpp"
+#include "simulation/integrators.hpp"
+
+namespace simon::simulation {
+namespace {
+
+constexpr std::size_t BODY_COUNT = 4096;
+constexpr std::size_t COLLISION_BODY_COUNT = 512;
+
+template <typename VectorType>
+struct Bodies final {
+  using ScalarType = typename VectorType::Scalar;
+
+  explicit Bodies(std::size_t count) {
+    std::mt19937 generate{42};
+    std::uniform_real_distribution<ScalarType> uniform{-100, 100};
+    auto random_vector = [&] { return VectorType{uniform(generate), uniform(generate), 0}; };
+    for (std::size_t i = 0; i < count; ++i) {
+      positions.push_back(random_vector());
+      velocities.push_back(random_vector());
+      accelerations.push_back(random_vector());
+      radii.push_back(ScalarType{1});
+    }
+  }
+
+  void integrate(ScalarType dt) {
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+      integrate_runge_kutta_2(&positions[i], &velocities[i], accelerations[i], dt);
+    }
+  }
+
+  std::size_t count_collisions() const {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+      for (std::size_t j = i + 1; j < positions.size(); ++j) {
+        count += has_collision(positions[i], radii[i], positions[j], radii[j]);
+      }
+    }
+    return count;
+  }
+
+  std::vector<VectorType> positions;
+  std::vector<VectorType> velocities;
+  std::vector<VectorType> accelerations;
+  std::vector<ScalarType> radii;
+};
+
+}  // namespace
+
+TEST_CASE("IntegratePrecision") {
+  Bodies<BasicVector<double, 3>> doubles{BODY_COUNT};
+  Bodies<BasicVector<float, 3>> floats{BODY_COUNT};
+  Bodies<BasicPaddedVector3<double>> padded_doubles{BODY_COUNT};
+  Bodies<BasicPaddedVector3<float>> padded_floats{BODY_COUNT};
+
+  BENCHMARK("RungeKutta2<double>") {
+    doubles.integrate(0.01);
+    return doubles.positions.front();
+  };
+
+  BENCHMARK("RungeKutta2<float>") {
+    floats.integrate(0.01f);
+    return floats.positions.front();
+  };
+
+  BENCHMARK("RungeKutta2<padded double>") {
+    padded_doubles.integrate(0.01);
+    return padded_doubles.positions.front();
+  };
+
+  BENCHMARK("RungeKutta2<padded float>") {
+    padded_floats.integrate(0.01f);
+    return padded_floats.positions.front();
+  };
+}
+
+TEST_CASE("CollisionPrecision") {
+  Bodies<BasicVector<double, 3>> doubles{COLLISION_BODY_COUNT};
+  Bodies<BasicVector<float, 3>> floats{COLLISION_BODY_COUNT};
+  Bodies<BasicPaddedVector3<double>> padded_doubles{COLLISION_BODY_COUNT};
+  Bodies<BasicPaddedVector3<float>> padded_floats{COLLISION_BODY_COUNT};
+
+  BENCHMARK("HasCollision<double>") { return doubles.count_collisions(); };
+  BENCHMARK("HasCollision<float>") { return floats.count_collisions(); };
+  BENCHMARK("HasCollision<padded double>") { return padded_doubles.count_collisions(); };
+  BENCHMARK("HasCollision<padded float>") { return padded_floats.count_collisions(); };
+}
+
+}  // namespace simon::simulation
@@ -0,0 +1,68 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+// Compares a simulation step with and without recording trajectories, which
+// should add no more than a few percent.
+// Run with `bazel run //simulation:recording_benchmark`.
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+#include "base/testing.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "simulation/simulation.hpp"
+#include "simulation/trajectory.hpp"
+
+namespace simon::simulation {
+namespace {
+
+constexpr std::size_t BODY_COUNT = 512;
+
+void populate(Simulation* simulation) {
+  std::mt19937 generate{42};
+  std::uniform_real_distribution<Scalar> uniform{-1000, 1000};
+  for (std::size_t i = 0; i < BODY_COUNT; ++i) {
+    auto* entity = simulation->create();
+    entity->component<component::Physical>()->radius = 1.0;
+    entity->component<component::Movement>()->position = {uniform(generate), uniform(generate), 0};
+    entity->component<component::Movement>()->velocity = {uniform(generate), uniform(generate), 0};
+  }
+}
+
+}  // namespace
+
+TEST_CASE("RecordingOverhead") {
+  const std::string path = std::filesystem::temp_directory_path() / "recording_benchmark.trj";
+  Simulation simulation;
+  populate(&simulation);
+  TimePoint time;
+
+  BENCHMARK("Step") {
+    simulation(time, Simulation::STEP_SIZE);
+    time += Simulation::STEP_SIZE;
+    return time;
+  };
+
+  TrajectoryRecorder recorder{path, BODY_COUNT};
+  BENCHMARK("StepAndRecord") {
+    simulation(time, Simulation::STEP_SIZE);
+    simulation.record(&recorder, time);
+    time += Simulation::STEP_SIZE;
+    return time;
+  };
+
+  TrajectoryRecorder compressed{path + ".compressed", BODY_COUNT, {.compress = true}};
+  BENCHMARK("StepAndRecordCompressed") {
+    simulation(time, Simulation::STEP_SIZE);
+    simulation.record(&compressed, time);
+    time += Simulation::STEP_SIZE;
+    return time;
+  };
+
+  recorder.close();
+  compressed.close();
+  std::remove(path.c_str());
+  std::remove((path + ".compressed").c_str());
+}
+
+}  // namespace simon::simulation
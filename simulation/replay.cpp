@@ -0,0 +1,95 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+// Reproduces a recorded run without a window or its original input sources:
+// restores the world from a snapshot, then steps it as fast as it will go while
+// feeding back the recorded inputs, until the log runs out.
+//
+//   bazel run //simulation:replay -- <snapshot> <event-log> [<trajectory>]
+//
+// Built with `--config=trace`, it also writes where each step spent its time
+// to $SIMON_TRACE_OUTPUT, or to replay.trace.json.
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/time.hpp"
+#include "base/trace.hpp"
+#include "framework/event_replay.hpp"
+#include "simulation/simulation.hpp"
+#include "simulation/trajectory.hpp"
+
+using namespace simon;
+using simulation::BodySnapshot;
+using simulation::ControlInput;
+using simulation::Simulation;
+
+// Steps between drains of the trace, well within what a thread's buffer holds.
+constexpr std::size_t TRACE_DRAIN_STEPS = 1000;
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " <snapshot> <event-log> [<trajectory>]\n";
+    return 1;
+  }
+
+  Simulation simulation;
+  auto time = simulation.restore(argv[1]);
+  if (!time) {
+    std::cerr << "Error: cannot restore snapshot " << argv[1] << "\n";
+    return 1;
+  }
+
+  framework::EventReplay replay{argv[2]};
+  if (!replay.is_open()) {
+    std::cerr << "Error: cannot read event log " << argv[2] << "\n";
+    return 1;
+  }
+  replay.replay<ControlInput>();
+
+  std::vector<BodySnapshot> bodies;
+  simulation.snapshot(&bodies);
+
+  std::unique_ptr<simulation::TrajectoryRecorder> recorder;
+  if (argc > 3) {
+    recorder = std::make_unique<simulation::TrajectoryRecorder>(argv[3], bodies.size());
+  }
+
+  std::unique_ptr<TraceWriter> trace;
+  if constexpr (TRACE_ENABLED) {
+    const char* trace_path = std::getenv("SIMON_TRACE_OUTPUT");
+    trace = std::make_unique<TraceWriter>(trace_path ? trace_path : "replay.trace.json");
+  }
+
+  std::size_t steps = 0;
+  for (; !replay.done(); ++steps, *time += Simulation::STEP_SIZE) {
+    replay.publish_until(*time, &simulation.events);
+    simulation(*time, Simulation::STEP_SIZE);
+    if (recorder) {
+      simulation.record(recorder.get(), *time);
+    }
+    if (trace && steps % TRACE_DRAIN_STEPS == 0) {
+      trace->drain();
+    }
+  }
+
+  if (recorder && !recorder->close()) {
+    std::cerr << "Error: cannot write trajectory " << argv[3] << "\n";
+    return 1;
+  }
+
+  if (trace && !trace->close()) {
+    std::cerr << "Error: cannot write trace\n";
+    return 1;
+  }
+
+  simulation.snapshot(&bodies);
+  std::cout << "Replayed " << steps << " steps to t=" << to_seconds(*time) << "s\n";
+  for (std::size_t i = 0; i < bodies.size(); ++i) {
+    std::cout << "  body " << i << ": (" << bodies[i].position[0] << ", "
+              << bodies[i].position[1] << ")\n";
+  }
+  return 0;
+}
@@ -0,0 +1,39 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+// Times saving and restoring a world of a million bodies.
+// Run with `bazel run //simulation:restore_benchmark`.
+
+#include <cstdio>
+#include <filesystem>
+
+#include "base/testing.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "simulation/simulation.hpp"
+
+namespace simon::simulation {
+namespace {
+
+constexpr std::size_t BODY_COUNT = 1'000'000;
+
+}  // namespace
+
+TEST_CASE("SnapshotRestore") {
+  const std::string path = std::filesystem::temp_directory_path() / "restore_benchmark.snap";
+  {
+    Simulation simulation{42};
+    for (std::size_t i = 0; i < BODY_COUNT; ++i) {
+      auto* movement = simulation.create()->component<component::Movement>();
+      movement->position = {Scalar(i), Scalar(0), Scalar(0)};
+    }
+    REQUIRE(simulation.save(path, TimePoint{}));
+  }
+
+  // After the first run the world refills the storage it kept, as a long run restored from its
+  // checkpoints does.
+  Simulation restored;
+  BENCHMARK("Restore") { return restored.restore(path); };
+
+  std::remove(path.c_str());
+}
+
+}  // namespace simon::simulation
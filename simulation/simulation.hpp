@@ -0,0 +1,370 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/core.hpp"
+#include "base/math.hpp"
+#include "base/memory.hpp"
+#include "base/time.hpp"
+#include "base/trace.hpp"
+#include "base/type_registry.hpp"
+#include "component/controls.hpp"
+#include "component/environment.hpp"
+#include "component/movement.hpp"
+#include "component/physical.hpp"
+#include "framework/component_system.hpp"
+#include "framework/entity.hpp"
+#include "framework/event_queue.hpp"
+#include "framework/snapshot.hpp"
+#include "framework/tick_rate.hpp"
+#include "simulation/collision.hpp"
+#include "simulation/integrators.hpp"
+#include "simulation/trajectory.hpp"
+
+namespace simon::simulation {
+
+// What a renderer needs of each body, copied out of the simulation each step.
+struct BodySnapshot final {
+  Vec2 position;
+  Scalar radius = 0.0;
+};
+
+// Sets a body's controlled acceleration. Inputs are published as events
+// rather than written to `Controls` directly so that they can be recorded and
+// replayed.
+struct ControlInput final {
+  std::uint64_t entity = 0;  // The body's `EntityName::value()`.
+  std::array<Scalar, 3> acceleration{};
+};
+
+// What the last step took, as counted by the simulation while stepping.
+struct StepStats final {
+  static constexpr std::size_t SYSTEM_COUNT = 4;
+  // Systems in the order they step.
+  static constexpr std::array<const char*, SYSTEM_COUNT> SYSTEM_NAMES = {
+    "environment", "physical", "controls", "movement"};
+
+  std::chrono::nanoseconds step_time{};  // Wall time.
+  std::array<std::chrono::nanoseconds, SYSTEM_COUNT> system_times{};  // Every tick of the step.
+  std::size_t events_processed = 0;
+  std::size_t events_pending = 0;  // Once the step is done.
+  std::size_t entity_count = 0;
+};
+
+class Simulation final {
+ public:
+  static constexpr Duration STEP_SIZE = std::chrono::milliseconds{100};
+  static constexpr std::size_t SUB_STEPS{10};
+
+  // Movement changes every substep; environment and controls are slowly
+  // changing inputs that only need refreshing once per step. Collisions are
+  // swept over the whole step, so are found once per step however fast the
+  // bodies move.
+  static constexpr framework::TickRate ENVIRONMENT_RATE = framework::TickRate::per_step(1);
+  static constexpr framework::TickRate CONTROLS_RATE = framework::TickRate::per_step(1);
+  static constexpr framework::TickRate PHYSICAL_RATE = framework::TickRate::per_step(1);
+  static constexpr framework::TickRate MOVEMENT_RATE = framework::TickRate::per_step(SUB_STEPS);
+
+  Simulation() {
+    events.subscribe<ControlInput>([this](TimePoint, const ControlInput& input) { apply(input); });
+    events.save_with_snapshots<ControlInput>();
+    events.save_with_logs<ControlInput>();
+  }
+
+  // Names entities from `seed` rather than from the process-wide random device, so that the world
+  // shares no state with others and names its entities the same in every run.
+  explicit Simulation(std::uint64_t seed) : Simulation{} { entity_seed_ = seed; }
+
+  Simulation(const Simulation&) = delete;
+  Simulation& operator=(const Simulation&) = delete;
+
+  framework::Entity* create() {
+    return create(entity_seed_ ? framework::Identity{next_entity_name()} : framework::Identity{});
+  }
+
+  void operator()(TimePoint time, Duration step) {
+    TRACE_SPAN("simulation", "step");
+    begin_memory_step();
+    if (counts_steps_) {
+      step_counted(time, step);
+    } else {
+      events.process_until(time);
+      step_systems(time, step, [](std::size_t) {});
+    }
+  }
+
+  // Off by default, so that worlds nobody watches, such as those of an ensemble, pay nothing
+  // for reading the clock around every system. Turning counting off clears what was counted.
+  void count_steps(bool enabled) {
+    counts_steps_ = enabled;
+    if (!enabled) {
+      step_stats_ = StepStats{};
+    }
+  }
+  // What the last step took, if counted; zero otherwise.
+  const StepStats& step_stats() const { return step_stats_; }
+
+  void snapshot(std::vector<BodySnapshot>* bodies) const {
+    bodies->clear();
+    physical_.for_each([bodies](const component::Physical& physical) {
+      const auto& position = physical.movement->position;
+      bodies->push_back({.position = {position[0], position[1]}, .radius = physical.radius});
+    });
+  }
+
+  // Copies every body's position and velocity into the recorder's next frame,
+  // in the same order as `snapshot()`.
+  void record(TrajectoryRecorder* recorder, TimePoint time) const {
+    CHECK_PRECONDITION(recorder->body_count() == movement_.size());
+    auto frame = recorder->frame(time);
+    std::size_t index = 0;
+    movement_.for_each([&frame, &index](const component::Movement& movement) {
+      frame.positions[index] = movement.position.xyz();
+      frame.velocities[index] = movement.velocity.xyz();
+      index++;
+    });
+  }
+
+  // Writes the world at `time` to a snapshot file. Only pending events of
+  // types registered with `events.save_with_snapshots()` are kept.
+  bool save(const std::string& path, TimePoint time) const {
+    framework::SnapshotWriter writer{path};
+    if (!writer.is_open()) {
+      return false;
+    }
+
+    std::vector<std::uint64_t> names;
+    names.reserve(entities_.size());
+    for (auto&& entity : entities_) {
+      names.push_back(entity.entity_name().value());
+    }
+    // The entity seed goes with the clock, so that a restored world names its next entities as the
+    // saved one would have.
+    const std::uint64_t clock[] = {static_cast<std::uint64_t>(time.time_since_epoch().count()),
+                                   step_index_, entity_seed_.has_value(), entity_seed_.value_or(0)};
+
+    writer.write(ENTITIES_TAG, std::span<const std::uint64_t>{names});
+    writer.write(CLOCK_TAG, std::span<const std::uint64_t>{clock});
+    controls_.save(&writer);
+    environment_.save(&writer);
+    physical_.save(&writer);
+    movement_.save(&writer);
+    events.save(&writer);
+    return writer.finish();
+  }
+
+  // Replaces the world with one saved by `save()` and returns the time it was
+  // saved at. Entities keep their names and the world takes the saved entity seed, if the
+  // snapshot has one; the world is left empty, with no events pending, on failure.
+  std::optional<TimePoint> restore(const std::string& path) {
+    framework::SnapshotReader reader{path};
+    auto names = reader.section<std::uint64_t>(ENTITIES_TAG);
+    auto clock = reader.section<std::uint64_t>(CLOCK_TAG);
+    clear();
+    // Snapshots from before the seed was saved have only the time and the step.
+    if (!reader.is_open() || (clock.size() != 2 && clock.size() != 4)) {
+      return std::nullopt;
+    }
+
+    // Components are made whole from their columns, then entities are made and wired to them: a
+    // bulk copy and a fix-up of pointers, with no allocation if the world held as many before.
+    bool restored = controls_.restore_detached(reader, names.size()) &&
+                    environment_.restore_detached(reader, names.size()) &&
+                    physical_.restore_detached(reader, names.size()) &&
+                    movement_.restore_detached(reader, names.size()) && events.restore(reader);
+    if (!restored) {
+      clear();
+      return std::nullopt;
+    }
+    create_all(names);
+
+    step_index_ = clock[1];
+    if (clock.size() == 4) {
+      entity_seed_ = clock[2] ? std::optional<std::uint64_t>{clock[3]} : std::nullopt;
+    }
+    return TimePoint{Duration{static_cast<Duration::rep>(clock[0])}};
+  }
+
+  // What each subsystem allocated: component systems by component type, then "events" and
+  // "entities". Allocations are counted from the start of the last step.
+  std::vector<NamedMemoryUsage> memory_usage() const {
+    return {
+      {type_record<component::Controls>().name, controls_.memory_usage()},
+      {type_record<component::Environment>().name, environment_.memory_usage()},
+      {type_record<component::Physical>().name, physical_.memory_usage()},
+      {type_record<component::Movement>().name, movement_.memory_usage()},
+      {"events", events.memory_usage()},
+      {"entities", entities_memory_usage()},
+    };
+  }
+
+  framework::EventQueue events;
+
+ private:
+  static constexpr framework::SnapshotTag ENTITIES_TAG =
+    framework::snapshot_tag("simulation/entities");
+  static constexpr framework::SnapshotTag CLOCK_TAG = framework::snapshot_tag("simulation/clock");
+
+  framework::Entity* create(framework::Identity id) {
+    auto* entity = add_entity(std::move(id));
+    connect(controls_.attach(entity), environment_.attach(entity), physical_.attach(entity),
+            movement_.attach(entity));
+    return entity;
+  }
+
+  framework::Entity* add_entity(framework::Identity id) {
+    auto* entity = &entities_.emplace_back(std::move(id));
+    const std::uint64_t name = entity->entity_name().value();
+    index_sorted_ =
+      index_sorted_ && (entities_by_name_.empty() || entities_by_name_.back().first < name);
+    entities_by_name_.emplace_back(name, entity);
+    return entity;
+  }
+
+  // Wires an entity's components to each other, which snapshots leave out.
+  static void connect(component::Controls* controls, component::Environment* environment,
+                      component::Physical* physical, component::Movement* movement) {
+    movement->environment = environment;
+    movement->physical = physical;
+    movement->controls = controls;
+    physical->movement = movement;
+  }
+
+  // Steps every system in turn, calling `lap(i)` after the i-th of `StepStats::SYSTEM_NAMES`.
+  template <typename LapType>
+  void step_systems(TimePoint time, Duration step, LapType&& lap) {
+    ENVIRONMENT_RATE(environment_, step_index_, time, step, &events);
+    lap(0);
+    PHYSICAL_RATE(physical_, step_index_, time, step, &events);
+    lap(1);
+    CONTROLS_RATE(controls_, step_index_, time, step, &events);
+    lap(2);
+    MOVEMENT_RATE(movement_, step_index_, time, step, &events);
+    lap(3);
+    step_index_++;
+  }
+
+  void step_counted(TimePoint time, Duration step) {
+    using Clock = std::chrono::steady_clock;
+    const auto begin = Clock::now();
+    step_stats_.events_processed = events.process_until(time);
+    auto lap = Clock::now();
+    step_systems(time, step, [this, &lap](std::size_t system) {
+      const auto now = Clock::now();
+      step_stats_.system_times[system] = now - lap;
+      lap = now;
+    });
+
+    step_stats_.events_pending = events.size();
+    step_stats_.entity_count = entities_.size();
+    step_stats_.step_time = lap - begin;
+  }
+
+  // Makes an entity of each name and gives the i-th the i-th component of every system, as made by
+  // `restore_detached()`. Storage and index are grown once for all of them.
+  void create_all(std::span<const std::uint64_t> names) {
+    entities_.reserve(entities_.size() + names.size());
+    entities_by_name_.reserve(entities_by_name_.size() + names.size());
+    for (std::size_t i = 0; i < names.size(); ++i) {
+      auto* entity = add_entity(framework::Identity{names[i]});
+      connect(controls_.attach(entity, i), environment_.attach(entity, i),
+              physical_.attach(entity, i), movement_.attach(entity, i));
+    }
+  }
+
+  // SplitMix64, https://prng.di.unimi.it/splitmix64.c
+  std::uint64_t next_entity_name() {
+    std::uint64_t name = (*entity_seed_ += 0x9E3779B97F4A7C15);
+    name = (name ^ (name >> 30)) * 0xBF58476D1CE4E5B9;
+    name = (name ^ (name >> 27)) * 0x94D049BB133111EB;
+    return name ^ (name >> 31);
+  }
+
+  // Sorts the index on the first lookup after entities were created, rather than on every create,
+  // so that making many entities, as on restore, costs one sort and no allocation each.
+  framework::Entity* find_entity(std::uint64_t name) {
+    auto by_name = [](const EntityIndex::value_type& a, const EntityIndex::value_type& b) {
+      return a.first < b.first;
+    };
+    if (!index_sorted_) {
+      std::sort(entities_by_name_.begin(), entities_by_name_.end(), by_name);
+      index_sorted_ = true;
+    }
+    auto entry = std::lower_bound(
+      entities_by_name_.begin(), entities_by_name_.end(), EntityIndex::value_type{name, nullptr},
+      by_name);
+    return entry != entities_by_name_.end() && entry->first == name ? entry->second : nullptr;
+  }
+
+  void apply(const ControlInput& input) {
+    if (auto* entity = find_entity(input.entity)) {
+      const auto& [x, y, z] = input.acceleration;
+      entity->component<component::Controls>()->acceleration = {x, y, z};
+    }
+  }
+
+  // The table of entities and their index by name. Entities keep what they are attached to out
+  // of sight.
+  MemoryUsage entities_memory_usage() const {
+    return {.reserved = entity_memory_.reserved(),
+            .in_use = entities_.size() * sizeof(framework::Entity) +
+                      entities_by_name_.size() * sizeof(EntityIndex::value_type),
+            .allocations = entity_memory_.allocations()};
+  }
+
+  void begin_memory_step() {
+    controls_.begin_memory_step();
+    environment_.begin_memory_step();
+    physical_.begin_memory_step();
+    movement_.begin_memory_step();
+    events.begin_memory_step();
+    entity_memory_.begin_step();
+  }
+
+  void clear() {
+    entities_.clear();
+    entities_by_name_.clear();
+    index_sorted_ = true;
+    controls_.clear();
+    environment_.clear();
+    physical_.clear();
+    movement_.clear();
+    events.clear();
+    step_index_ = 0;
+  }
+
+  framework::ComponentSystem<component::Controls, framework::ComputeNone> controls_;
+  framework::ComponentSystem<component::Environment, framework::ComputeNone> environment_;
+  framework::ComponentSystem<component::Physical, DetectSweptCollision> physical_;
+  framework::ComponentSystem<component::Movement, ComputeMovement> movement_;
+
+  // Entities by name, sorted by `find_entity()` when needed. Names are unique.
+  using EntityIndex =
+    std::vector<std::pair<std::uint64_t, framework::Entity*>,
+                CountingAllocator<std::pair<std::uint64_t, framework::Entity*>>>;
+
+  MemoryAccount entity_memory_;
+  // Stable addresses, which components and the index point to.
+  BlockVector<framework::Entity, CountingAllocator<framework::Entity>> entities_{
+    CountingAllocator<framework::Entity>{&entity_memory_}};
+  EntityIndex entities_by_name_{CountingAllocator<EntityIndex::value_type>{&entity_memory_}};
+  bool index_sorted_ = true;
+  std::optional<std::uint64_t> entity_seed_;
+  std::size_t step_index_ = 0;
+  bool counts_steps_ = false;
+  StepStats step_stats_;
+};
+
+}  // namespace simon::simulation
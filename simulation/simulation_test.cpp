@@ -0,0 +1,282 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "simulation/simulation.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <span>
+
+#include "framework/event_replay.hpp"
+
+#include "base/testing.hpp"
+
+namespace simon::simulation {
+
+TEST_CASE("Simulation") {
+  Simulation simulation;
+  auto* a = simulation.create();
+  auto* b = simulation.create();
+
+  a->component<component::Physical>()->radius = 1.0;
+  a->component<component::Movement>()->position = {0.0, 0.0, 0.0};
+  a->component<component::Movement>()->velocity = {10.0, 0.0, 0.0};
+  b->component<component::Physical>()->radius = 1.0;
+  b->component<component::Movement>()->position = {10.0, 0.0, 0.0};
+
+  SECTION("ShouldSnapshotEveryBody") {
+    std::vector<BodySnapshot> bodies;
+    simulation.snapshot(&bodies);
+
+    REQUIRE(bodies.size() == 2);
+    CHECK(bodies[1].position.isApprox(Vec2{10.0, 0.0}));
+    CHECK(bodies[1].radius == Scalar{1.0});
+  }
+
+  SECTION("ShouldMoveBodiesEachStep") {
+    TimePoint time;
+    simulation(time, Simulation::STEP_SIZE);
+
+    std::vector<BodySnapshot> bodies;
+    simulation.snapshot(&bodies);
+
+    REQUIRE(bodies.size() == 2);
+    CHECK(bodies[0].position[0] > 0.0);
+  }
+
+  SECTION("ShouldNotCountStepsByDefault") {
+    simulation.events.publish<ControlInput>(TimePoint{}, ControlInput{});
+    simulation(TimePoint{}, Simulation::STEP_SIZE);
+
+    CHECK(simulation.step_stats().events_processed == 0);
+    CHECK(simulation.step_stats().step_time == std::chrono::nanoseconds{0});
+  }
+
+  SECTION("ShouldCountWhatEachStepTook") {
+    simulation.count_steps(true);
+    simulation.events.publish<ControlInput>(TimePoint{}, ControlInput{});
+    simulation(TimePoint{}, Simulation::STEP_SIZE);
+
+    const auto& stats = simulation.step_stats();
+    CHECK(stats.events_processed == 1);
+    CHECK(stats.events_pending == 0);
+    CHECK(stats.entity_count == 2);
+    std::chrono::nanoseconds system_time{};
+    for (auto time : stats.system_times) {
+      system_time += time;
+    }
+    CHECK(system_time > std::chrono::nanoseconds{0});
+    CHECK(stats.step_time >= system_time);
+  }
+
+  SECTION("ShouldForgetCountsOnceCountingStops") {
+    simulation.count_steps(true);
+    simulation.events.publish<ControlInput>(TimePoint{}, ControlInput{});
+    simulation(TimePoint{}, Simulation::STEP_SIZE);
+
+    simulation.count_steps(false);
+
+    CHECK(simulation.step_stats().events_processed == 0);
+    CHECK(simulation.step_stats().entity_count == 0);
+    CHECK(simulation.step_stats().step_time == std::chrono::nanoseconds{0});
+  }
+
+  SECTION("ShouldAccountMemoryOfEverySubsystem") {
+    TimePoint time;
+    simulation(time, Simulation::STEP_SIZE);
+
+    auto usages = simulation.memory_usage();
+
+    REQUIRE(usages.size() == 6);
+    CHECK(usages[0].name == type_record<component::Controls>().name);
+    CHECK(usages[4].name == "events");
+    CHECK(usages[5].name == "entities");
+    for (auto&& [name, usage] : usages) {
+      CHECK(usage.in_use > 0);
+      CHECK(usage.reserved >= usage.in_use);
+    }
+    CHECK(usages[5].usage.in_use >= 2 * sizeof(framework::Entity));
+  }
+
+  SECTION("ShouldPublishCollisionWhenBodiesMeet") {
+    bool collided = false;
+    simulation.events.subscribe<Collision>(
+      [&collided](TimePoint, const Collision&) { collided = true; });
+
+    TimePoint time;
+    for (int i = 0; i < 20 && !collided; ++i, time += Simulation::STEP_SIZE) {
+      simulation(time, Simulation::STEP_SIZE);
+    }
+
+    CHECK(collided);
+  }
+
+  SECTION("ShouldNotLetFastBodiesPassThrough") {
+    // Passes right through `b` within the first step, overlapping it at no substep.
+    a->component<component::Movement>()->velocity = {200.0, 0.0, 0.0};
+    TimePoint collided_at = TimePoint::max();
+    simulation.events.subscribe<Collision>(
+      [&collided_at](TimePoint, const Collision& collision) { collided_at = collision.time; });
+
+    simulation(TimePoint{}, Simulation::STEP_SIZE);
+    simulation.events.process_until(TimePoint{Simulation::STEP_SIZE});
+
+    CHECK(collided_at == TimePoint{from_seconds(0.04)});
+  }
+
+  SECTION("ShouldRecordEveryBody") {
+    const std::string path = std::filesystem::temp_directory_path() / "simulation_test.trj";
+    {
+      TrajectoryRecorder recorder{path, 2};
+      TimePoint time;
+      simulation(time, Simulation::STEP_SIZE);
+      simulation.record(&recorder, time);
+      REQUIRE(recorder.close());
+    }
+
+    TrajectoryReader reader{path};
+    TrajectoryChunk chunk;
+    REQUIRE(reader.next(&chunk));
+    std::remove(path.c_str());
+
+    std::vector<BodySnapshot> bodies;
+    simulation.snapshot(&bodies);
+    REQUIRE(chunk.frame_count == 1);
+    CHECK(chunk.positions[0].head<2>() == bodies[0].position);
+    CHECK(chunk.positions[1].head<2>() == bodies[1].position);
+  }
+
+  SECTION("ShouldRestoreSavedWorld") {
+    const std::string path = std::filesystem::temp_directory_path() / "simulation_test.snap";
+    TimePoint time{from_seconds(0.5)};
+    simulation(time, Simulation::STEP_SIZE);
+    REQUIRE(simulation.save(path, time));
+
+    Simulation restored;
+    restored.create();
+    auto restored_time = restored.restore(path);
+    std::remove(path.c_str());
+
+    REQUIRE(restored_time);
+    CHECK(*restored_time == time);
+
+    std::vector<BodySnapshot> expected, bodies;
+    simulation.snapshot(&expected);
+    restored.snapshot(&bodies);
+    REQUIRE(bodies.size() == 2);
+    CHECK(bodies[0].position == expected[0].position);
+    CHECK(bodies[1].radius == expected[1].radius);
+
+    // Stepping on from the restored world matches stepping the original.
+    time += Simulation::STEP_SIZE;
+    simulation(time, Simulation::STEP_SIZE);
+    restored(time, Simulation::STEP_SIZE);
+    simulation.snapshot(&expected);
+    restored.snapshot(&bodies);
+    CHECK(bodies[0].position == expected[0].position);
+  }
+
+  SECTION("ShouldApplyControlInputs") {
+    simulation.events.publish<ControlInput>(
+      TimePoint{}, ControlInput{.entity = b->entity_name().value(), .acceleration = {0, 5, 0}});
+    simulation(TimePoint{}, Simulation::STEP_SIZE);
+
+    CHECK(b->component<component::Controls>()->acceleration[1] == Scalar{5});
+  }
+
+  SECTION("ShouldReplayRecordedInputs") {
+    const std::string snapshot_path =
+      std::filesystem::temp_directory_path() / "simulation_test_replay.snap";
+    const std::string log_path =
+      std::filesystem::temp_directory_path() / "simulation_test_replay.log";
+    REQUIRE(simulation.save(snapshot_path, TimePoint{}));
+
+    // Record a run with inputs arriving part way through.
+    TimePoint time;
+    {
+      framework::EventLogWriter log{log_path};
+      simulation.events.record(&log);
+      for (int i = 0; i < 10; ++i, time += Simulation::STEP_SIZE) {
+        if (i == 3) {
+          simulation.events.publish<ControlInput>(
+            time, ControlInput{.entity = a->entity_name().value(), .acceleration = {0, -9, 0}});
+        }
+        simulation(time, Simulation::STEP_SIZE);
+      }
+      simulation.events.record(nullptr);
+    }
+
+    // Replay from the same starting world without the original inputs.
+    Simulation replayed;
+    auto replay_time = replayed.restore(snapshot_path);
+    REQUIRE(replay_time);
+    framework::EventReplay replay{log_path};
+    replay.replay<ControlInput>();
+    for (; *replay_time < time; *replay_time += Simulation::STEP_SIZE) {
+      replay.publish_until(*replay_time, &replayed.events);
+      replayed(*replay_time, Simulation::STEP_SIZE);
+    }
+    std::remove(snapshot_path.c_str());
+    std::remove(log_path.c_str());
+
+    std::vector<BodySnapshot> expected, bodies;
+    simulation.snapshot(&expected);
+    replayed.snapshot(&bodies);
+    REQUIRE(bodies.size() == 2);
+    CHECK(bodies[0].position == expected[0].position);
+    CHECK(bodies[1].position == expected[1].position);
+  }
+
+  SECTION("ShouldNotRestoreMissingSnapshot") {
+    CHECK(!simulation.restore("/nonexistent/simulation_test.snap"));
+  }
+
+  SECTION("ShouldLeaveWorldEmptyWhenSnapshotIsIncomplete") {
+    // Entities and a clock, but none of their components.
+    const std::string path = std::filesystem::temp_directory_path() / "simulation_test_part.snap";
+    {
+      framework::SnapshotWriter writer{path};
+      const std::uint64_t names[] = {1, 2};
+      const std::uint64_t clock[] = {0, 7};
+      writer.write(framework::snapshot_tag("simulation/entities"),
+                   std::span<const std::uint64_t>{names});
+      writer.write(framework::snapshot_tag("simulation/clock"),
+                   std::span<const std::uint64_t>{clock});
+      REQUIRE(writer.finish());
+    }
+    simulation.events.publish<ControlInput>(TimePoint{from_seconds(1.0)}, ControlInput{});
+    simulation(TimePoint{}, Simulation::STEP_SIZE);
+
+    CHECK(!simulation.restore(path));
+    std::remove(path.c_str());
+
+    std::vector<BodySnapshot> bodies;
+    simulation.snapshot(&bodies);
+    CHECK(bodies.empty());
+    CHECK(simulation.events.size() == 0);
+    CHECK(simulation.memory_usage()[5].usage.in_use == 0);
+  }
+
+  SECTION("ShouldNameEntitiesFromSeed") {
+    Simulation seeded{7}, same{7}, other{8};
+    auto name = seeded.create()->entity_name().value();
+
+    CHECK(same.create()->entity_name().value() == name);
+    CHECK(other.create()->entity_name().value() != name);
+    CHECK(seeded.create()->entity_name().value() != name);
+  }
+
+  SECTION("ShouldNameEntitiesAsSavedWorldWouldAfterRestore") {
+    const std::string path = std::filesystem::temp_directory_path() / "simulation_test_seed.snap";
+    Simulation seeded{7};
+    seeded.create();
+    REQUIRE(seeded.save(path, TimePoint{}));
+
+    Simulation restored{8};
+    REQUIRE(restored.restore(path));
+    std::remove(path.c_str());
+
+    CHECK(restored.create()->entity_name().value() == seeded.create()->entity_name().value());
+  }
+}
+
+}  // namespace simon::simulation
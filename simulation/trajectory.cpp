@@ -0,0 +1,295 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "simulation/trajectory.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace simon::simulation {
+namespace {
+constexpr char TRAJECTORY_MAGIC[8] = {'S', 'I', 'M', 'O', 'N', 'T', 'R', 'J'};
+
+// A control byte with the high bit set stands for (low bits + 1) zero bytes;
+// otherwise (control + 1) literal bytes follow it.
+constexpr std::uint8_t ZERO_RUN_BIT = 0x80;
+constexpr std::size_t MAX_RUN = 128;
+
+template <typename ValueType>
+std::span<const std::byte> as_bytes(const std::vector<ValueType>& values) {
+  return std::as_bytes(std::span{values});
+}
+
+template <typename ValueType>
+std::span<std::byte> as_writable_bytes(std::vector<ValueType>* values) {
+  return std::as_writable_bytes(std::span{*values});
+}
+
+// XORs each byte with the byte one frame (`stride` bytes) earlier and
+// collapses runs of zeros.
+void encode_column(std::span<const std::byte> column,
+                   std::size_t stride,
+                   std::vector<std::byte>* encoded) {
+  auto delta = [column, stride](std::size_t i) {
+    return i < stride ? column[i] : column[i] ^ column[i - stride];
+  };
+
+  encoded->clear();
+  for (std::size_t i = 0; i < column.size();) {
+    std::size_t run = 0;
+    if (delta(i) == std::byte{0}) {
+      while (i + run < column.size() && run < MAX_RUN && delta(i + run) == std::byte{0}) {
+        run++;
+      }
+      encoded->push_back(std::byte(ZERO_RUN_BIT | (run - 1)));
+    } else {
+      auto control = encoded->size();
+      encoded->emplace_back();
+      while (i + run < column.size() && run < MAX_RUN && delta(i + run) != std::byte{0}) {
+        encoded->push_back(delta(i + run));
+        run++;
+      }
+      (*encoded)[control] = std::byte(run - 1);
+    }
+    i += run;
+  }
+}
+
+bool decode_column(std::span<const std::byte> encoded,
+                   std::size_t stride,
+                   std::span<std::byte> column) {
+  std::size_t out = 0;
+  for (std::size_t in = 0; in < encoded.size();) {
+    auto control = std::to_integer<std::uint8_t>(encoded[in++]);
+    std::size_t run = (control & ~ZERO_RUN_BIT) + 1;
+    if (run > column.size() - out) {
+      return false;
+    }
+    if (control & ZERO_RUN_BIT) {
+      std::memset(column.data() + out, 0, run);
+    } else {
+      if (run > encoded.size() - in) {
+        return false;
+      }
+      std::memcpy(column.data() + out, encoded.data() + in, run);
+      in += run;
+    }
+    out += run;
+  }
+
+  for (std::size_t i = stride; i < column.size(); ++i) {
+    column[i] ^= column[i - stride];
+  }
+  return out == column.size();
+}
+
+// Recording could never start without a chunk to fill, nor fill a chunk without a frame.
+TrajectoryOptions at_least_one(TrajectoryOptions options) {
+  options.frames_per_chunk = std::max<std::size_t>(options.frames_per_chunk, 1);
+  options.chunks_in_flight = std::max<std::size_t>(options.chunks_in_flight, 1);
+  return options;
+}
+}  // namespace
+
+TrajectoryRecorder::TrajectoryRecorder(const std::string& path,
+                                       std::size_t body_count,
+                                       TrajectoryOptions options)
+    : body_count_{body_count},
+      options_{at_least_one(options)},
+      file_{std::fopen(path.c_str(), "wb")} {
+  TrajectoryHeader header{};
+  std::memcpy(header.magic, TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC));
+  header.version = TRAJECTORY_VERSION;
+  header.scalar_size = sizeof(Scalar);
+  header.body_count = body_count_;
+  failed_ = !file_ || std::fwrite(&header, sizeof(header), 1, file_) != 1;
+
+  // Allocate every chunk up front so that recording never allocates.
+  for (std::size_t i = 0; i < options_.chunks_in_flight; ++i) {
+    auto chunk = std::make_unique<Chunk>();
+    chunk->times.resize(options_.frames_per_chunk);
+    chunk->positions.resize(options_.frames_per_chunk * body_count_);
+    chunk->velocities.resize(options_.frames_per_chunk * body_count_);
+    free_.push_back(std::move(chunk));
+  }
+
+  writer_ = std::thread{[this] { write_chunks(); }};
+}
+
+TrajectoryRecorder::~TrajectoryRecorder() { close(); }
+
+TrajectoryFrame TrajectoryRecorder::frame(TimePoint time) {
+  if (current_ && current_->frame_count == options_.frames_per_chunk) {
+    submit();
+  }
+  if (!current_) {
+    std::unique_lock lock{mutex_};
+    chunk_freed_.wait(lock, [this] { return !free_.empty(); });
+    current_ = std::move(free_.back());
+    free_.pop_back();
+  }
+
+  auto index = current_->frame_count++;
+  auto offset = index * body_count_;
+  current_->times[index] = time.time_since_epoch().count();
+  return {.positions = {current_->positions.data() + offset, body_count_},
+          .velocities = {current_->velocities.data() + offset, body_count_}};
+}
+
+bool TrajectoryRecorder::close() {
+  if (!writer_.joinable()) {
+    return !failed_;
+  }
+
+  if (current_ && current_->frame_count) {
+    submit();
+  }
+  {
+    std::lock_guard lock{mutex_};
+    closing_ = true;
+  }
+  chunk_filled_.notify_one();
+  writer_.join();
+
+  if (file_) {
+    failed_ |= std::fclose(file_) != 0;
+    file_ = nullptr;
+  }
+  return !failed_;
+}
+
+void TrajectoryRecorder::submit() {
+  {
+    std::lock_guard lock{mutex_};
+    full_.push_back(std::move(current_));
+  }
+  chunk_filled_.notify_one();
+}
+
+void TrajectoryRecorder::write_chunks() {
+  while (true) {
+    std::unique_ptr<Chunk> chunk;
+    {
+      std::unique_lock lock{mutex_};
+      chunk_filled_.wait(lock, [this] { return closing_ || !full_.empty(); });
+      if (full_.empty()) {
+        return;
+      }
+      chunk = std::move(full_.front());
+      full_.pop_front();
+    }
+
+    write_chunk(*chunk);
+    chunk->frame_count = 0;
+
+    {
+      std::lock_guard lock{mutex_};
+      free_.push_back(std::move(chunk));
+    }
+    chunk_freed_.notify_one();
+  }
+}
+
+void TrajectoryRecorder::write_chunk(const Chunk& chunk) {
+  if (failed_) {
+    return;
+  }
+
+  const std::size_t values = chunk.frame_count * body_count_;
+  const std::span<const std::byte> columns[3] = {
+    as_bytes(chunk.times).first(chunk.frame_count * sizeof(TimePoint::rep)),
+    as_bytes(chunk.positions).first(values * sizeof(Vec3)),
+    as_bytes(chunk.velocities).first(values * sizeof(Vec3)),
+  };
+  const std::size_t strides[3] = {
+    sizeof(TimePoint::rep), body_count_ * sizeof(Vec3), body_count_ * sizeof(Vec3)};
+
+  TrajectoryChunkHeader header{};
+  header.frame_count = static_cast<std::uint32_t>(chunk.frame_count);
+  header.compressed = options_.compress;
+
+  std::span<const std::byte> stored[3];
+  for (std::size_t i = 0; i < 3; ++i) {
+    if (options_.compress) {
+      encode_column(columns[i], strides[i], &encoded_[i]);
+      stored[i] = encoded_[i];
+    } else {
+      stored[i] = columns[i];
+    }
+    header.column_sizes[i] = stored[i].size();
+  }
+
+  failed_ |= std::fwrite(&header, sizeof(header), 1, file_) != 1;
+  for (auto column : stored) {
+    failed_ |= std::fwrite(column.data(), 1, column.size(), file_) != column.size();
+  }
+}
+
+TrajectoryReader::TrajectoryReader(const std::string& path)
+    : file_{std::fopen(path.c_str(), "rb")} {
+  TrajectoryHeader header{};
+  bool valid = file_ && std::fread(&header, sizeof(header), 1, file_) == 1 &&
+               std::memcmp(header.magic, TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC)) == 0 &&
+               header.version == TRAJECTORY_VERSION && header.scalar_size == sizeof(Scalar);
+  if (!valid) {
+    if (file_) {
+      std::fclose(file_);
+    }
+    file_ = nullptr;
+    return;
+  }
+  body_count_ = header.body_count;
+}
+
+TrajectoryReader::~TrajectoryReader() {
+  if (file_) {
+    std::fclose(file_);
+  }
+}
+
+bool TrajectoryReader::next(TrajectoryChunk* chunk) {
+  TrajectoryChunkHeader header{};
+  if (!file_ || std::fread(&header, sizeof(header), 1, file_) != 1) {
+    return false;
+  }
+
+  const std::size_t values = header.frame_count * body_count_;
+  std::vector<TimePoint::rep> times(header.frame_count);
+  chunk->frame_count = header.frame_count;
+  chunk->positions.resize(values);
+  chunk->velocities.resize(values);
+
+  const std::span<std::byte> columns[3] = {
+    as_writable_bytes(&times),
+    as_writable_bytes(&chunk->positions),
+    as_writable_bytes(&chunk->velocities),
+  };
+  const std::size_t strides[3] = {
+    sizeof(TimePoint::rep), body_count_ * sizeof(Vec3), body_count_ * sizeof(Vec3)};
+
+  for (std::size_t i = 0; i < 3; ++i) {
+    const std::size_t size = header.column_sizes[i];
+    if (header.compressed ? size > 2 * columns[i].size() + 1 : size != columns[i].size()) {
+      return false;
+    }
+    if (!header.compressed) {
+      if (std::fread(columns[i].data(), 1, size, file_) != size) {
+        return false;
+      }
+      continue;
+    }
+
+    buffer_.resize(size);
+    if (std::fread(buffer_.data(), 1, size, file_) != size ||
+        !decode_column(buffer_, strides[i], columns[i])) {
+      return false;
+    }
+  }
+
+  chunk->times.clear();
+  for (auto rep : times) {
+    chunk->times.push_back(TimePoint{Duration{rep}});
+  }
+  return true;
+}
+
+}  // namespace simon::simulation
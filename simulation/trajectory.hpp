@@ -0,0 +1,141 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/math.hpp"
+#include "base/time.hpp"
+
+namespace simon::simulation {
+
+// Trajectory files hold every body's position and velocity at each recorded
+// frame. Frames are grouped into chunks, and each chunk stores its columns one
+// after another so that a column can be read back without touching the others:
+//
+//   TrajectoryHeader | TrajectoryChunkHeader times positions velocities | ...
+//
+// Compressed columns XOR each value against the same body's value in the
+// previous frame, which leaves mostly zero bytes for smooth motion, and then
+// collapse runs of zero bytes.
+constexpr std::uint32_t TRAJECTORY_VERSION = 1;
+
+struct TrajectoryHeader final {
+  char magic[8];
+  std::uint32_t version = 0;
+  std::uint32_t scalar_size = 0;
+  std::uint64_t body_count = 0;
+};
+
+struct TrajectoryChunkHeader final {
+  std::uint32_t frame_count = 0;
+  std::uint32_t compressed = 0;
+  std::uint64_t column_sizes[3] = {};  // Stored bytes of times, positions and velocities.
+};
+
+// Counts below one are taken as one.
+struct TrajectoryOptions final {
+  std::size_t frames_per_chunk = 64;
+  // Chunks the writer may fall behind by before recording waits for it.
+  std::size_t chunks_in_flight = 4;
+  bool compress = false;
+};
+
+// One frame's columns, filled in place by the caller.
+struct TrajectoryFrame final {
+  std::span<Vec3> positions;
+  std::span<Vec3> velocities;
+};
+
+// Frames decoded from one chunk, laid out frame by frame.
+struct TrajectoryChunk final {
+  std::size_t frame_count = 0;
+  std::vector<TimePoint> times;
+  std::vector<Vec3> positions;
+  std::vector<Vec3> velocities;
+};
+
+// Records frames into preallocated chunks on the simulation thread and hands
+// full chunks to a writer thread, so a step only pays for copying its columns.
+class TrajectoryRecorder final {
+ public:
+  TrajectoryRecorder(const std::string& path,
+                     std::size_t body_count,
+                     TrajectoryOptions options = {});
+  ~TrajectoryRecorder();
+
+  TrajectoryRecorder(const TrajectoryRecorder&) = delete;
+  TrajectoryRecorder& operator=(const TrajectoryRecorder&) = delete;
+
+  bool is_open() const { return file_ != nullptr; }
+  std::size_t body_count() const { return body_count_; }
+
+  // Starts a frame at `time`. The returned columns are valid until the next
+  // call and hold `body_count()` values each.
+  TrajectoryFrame frame(TimePoint time);
+
+  // Writes any partial chunk and waits for the writer. Returns false if any
+  // write failed. No frames may be recorded afterwards.
+  bool close();
+
+ private:
+  struct Chunk final {
+    std::size_t frame_count = 0;
+    std::vector<TimePoint::rep> times;
+    std::vector<Vec3> positions;
+    std::vector<Vec3> velocities;
+  };
+
+  void submit();
+  void write_chunks();
+  void write_chunk(const Chunk& chunk);
+
+  const std::size_t body_count_;
+  const TrajectoryOptions options_;
+  std::FILE* file_ = nullptr;
+  // Owned by the writer thread until it is joined.
+  bool failed_ = false;
+  std::vector<std::byte> encoded_[3];
+
+  std::unique_ptr<Chunk> current_;
+  std::vector<std::unique_ptr<Chunk>> free_;
+  std::deque<std::unique_ptr<Chunk>> full_;
+  bool closing_ = false;
+  std::mutex mutex_;
+  std::condition_variable chunk_freed_;
+  std::condition_variable chunk_filled_;
+  std::thread writer_;
+};
+
+class TrajectoryReader final {
+ public:
+  explicit TrajectoryReader(const std::string& path);
+  ~TrajectoryReader();
+
+  TrajectoryReader(const TrajectoryReader&) = delete;
+  TrajectoryReader& operator=(const TrajectoryReader&) = delete;
+
+  // True if the file is a trajectory of this version and scalar type.
+  bool is_open() const { return file_ != nullptr; }
+  std::size_t body_count() const { return body_count_; }
+
+  // Reads the next chunk. Returns false at the end of the file or on error.
+  bool next(TrajectoryChunk* chunk);
+
+ private:
+  std::FILE* file_ = nullptr;
+  std::size_t body_count_ = 0;
+  std::vector<std::byte> buffer_;
+};
+
+}  // namespace simon::simulation
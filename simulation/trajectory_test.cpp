@@ -0,0 +1,96 @@
+// Copyright 2022 -- CONTRIBUTORS. See LICENSE.
+
+#include "simulation/trajectory.hpp"
+
+#include <cstdio>
+#include <filesystem>
+
+#include "base/testing.hpp"
+
+namespace simon::simulation {
+
+TEST_CASE("Trajectory") {
+  const std::string path = std::filesystem::temp_directory_path() / "trajectory_test.trj";
+  constexpr std::size_t BODY_COUNT = 3;
+  constexpr std::size_t FRAME_COUNT = 10;
+  TrajectoryOptions options{.frames_per_chunk = 4, .chunks_in_flight = 2};
+
+  auto position = [](std::size_t frame, std::size_t body) {
+    return Vec3{Scalar(frame) * Scalar{0.5}, Scalar(body), 0.0};
+  };
+  auto velocity = [](std::size_t frame, std::size_t body) { return Vec3{0.5, 0.0, Scalar(body)}; };
+
+  auto record = [&] {
+    TrajectoryRecorder recorder{path, BODY_COUNT, options};
+    REQUIRE(recorder.is_open());
+    for (std::size_t frame = 0; frame < FRAME_COUNT; ++frame) {
+      auto columns = recorder.frame(TimePoint{from_seconds(frame * 0.1)});
+      REQUIRE(columns.positions.size() == BODY_COUNT);
+      for (std::size_t body = 0; body < BODY_COUNT; ++body) {
+        columns.positions[body] = position(frame, body);
+        columns.velocities[body] = velocity(frame, body);
+      }
+    }
+    REQUIRE(recorder.close());
+  };
+
+  auto check_read_back = [&] {
+    TrajectoryReader reader{path};
+    REQUIRE(reader.is_open());
+    CHECK(reader.body_count() == BODY_COUNT);
+
+    std::size_t frame = 0;
+    std::size_t chunks = 0;
+    TrajectoryChunk chunk;
+    while (reader.next(&chunk)) {
+      chunks++;
+      for (std::size_t i = 0; i < chunk.frame_count; ++i, ++frame) {
+        CHECK(chunk.times[i] == TimePoint{from_seconds(frame * 0.1)});
+        for (std::size_t body = 0; body < BODY_COUNT; ++body) {
+          CHECK(chunk.positions[i * BODY_COUNT + body] == position(frame, body));
+          CHECK(chunk.velocities[i * BODY_COUNT + body] == velocity(frame, body));
+        }
+      }
+    }
+    CHECK(frame == FRAME_COUNT);
+    CHECK(chunks == 3);
+  };
+
+  SECTION("ShouldReadBackRecordedFrames") {
+    record();
+    check_read_back();
+  }
+
+  SECTION("ShouldReadBackCompressedFrames") {
+    options.compress = true;
+    record();
+    check_read_back();
+  }
+
+  SECTION("ShouldRecordWithoutChunksInFlight") {
+    options.chunks_in_flight = 0;
+    record();
+    check_read_back();
+  }
+
+  SECTION("ShouldCompressSmoothMotion") {
+    record();
+    auto raw_size = std::filesystem::file_size(path);
+    options.compress = true;
+    record();
+    CHECK(std::filesystem::file_size(path) < raw_size / 2);
+  }
+
+  SECTION("ShouldNotOpenOtherFiles") {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    std::fputs("not a trajectory", file);
+    std::fclose(file);
+
+    TrajectoryReader reader{path};
+    CHECK(!reader.is_open());
+  }
+
+  std::remove(path.c_str());
+}
+
+}  // namespace simon::simulation